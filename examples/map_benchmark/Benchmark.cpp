@@ -1,23 +1,41 @@
 #include <Benchmark.h>
+#include <unordered_map>
 
 namespace Benchmark {
 
   std::string Result::csv_header() {
-    return "operation,map_type,key_type,val_type,shard_count,total_operations,thread_count,avg_operations_per_ms,total_elapsed_ms\n";
+    return "operation,map_type,key_type,val_type,shard_count,total_operations,thread_count,repetitions,avg_operations_per_ms,median_elapsed_ns,min_elapsed_ns,stddev_elapsed_ns,speedup_vs_"
+           "mutex_map\n";
   }
 
   std::string Result::csv_row() const {
     std::stringstream s;
-    s << operation << "," << map_type << "," << key_type << "," << val_type << "," << shard_count << "," << total_operations << "," << thread_count << "," << avg_operations_per_ms << ","
-      << total_elapsed_ms.count() << "\n";
+    s << operation << "," << map_type << "," << key_type << "," << val_type << "," << shard_count << "," << total_operations << "," << thread_count << "," << repetitions << ","
+      << avg_operations_per_ms << "," << median_elapsed_ns.count() << "," << min_elapsed_ns.count() << "," << stddev_elapsed_ns.count() << "," << speedup_vs_mutex_map << "\n";
     return s.str();
   }
 
   std::string Result::results_to_csv(std::vector<Result> const &results) {
+    // Index the mutex-wrapped baseline rows so every other row can report
+    // its throughput relative to the obvious hand-rolled alternative.
+    std::unordered_map<std::string, double> baselines;
+    for (auto const &r: results) {
+      if (r.map_type == "StdMutexMap") {
+        baselines[r.operation + "|" + r.key_type + "|" + r.val_type] = r.avg_operations_per_ms;
+      }
+    }
+
     std::stringstream s;
     s << Result::csv_header();
     for (auto const &r: results) {
-      s << r.csv_row();
+      Result row      = r;
+      auto const base = baselines.find(r.operation + "|" + r.key_type + "|" + r.val_type);
+      if (base != baselines.end() && base->second > 0.0) {
+        std::stringstream speedup;
+        speedup << (r.avg_operations_per_ms / base->second);
+        row.speedup_vs_mutex_map = speedup.str();
+      }
+      s << row.csv_row();
     }
     return s.str();
   }
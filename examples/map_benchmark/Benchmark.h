@@ -2,14 +2,174 @@
 #define BENCHMARK
 
 #include <concurrency/ShardedUnorderedMap.hpp>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
-constexpr uint64_t default_benchmark_iterations = 1'000'000;
+constexpr uint64_t default_benchmark_iterations        = 1'000'000;
+constexpr uint64_t default_benchmark_warmup_iterations = 10'000;
+constexpr uint32_t default_benchmark_repetitions       = 5;
+
+namespace Benchmark {
+
+  // Baseline adapter: a plain std::unordered_map behind the same surface
+  // the registered benchmarks use. NOT thread-safe; the harness runs it
+  // on a single thread so its rows quantify raw single-threaded map cost
+  // with zero synchronization.
+  template <typename Key, typename Val>
+  class RawStdMap {
+  public:
+    using internal_map_type = std::unordered_map<Key, Val>;
+    using key_type          = typename internal_map_type::key_type;
+    using mapped_type       = typename internal_map_type::mapped_type;
+    using value_type        = typename internal_map_type::value_type;
+    using size_type         = typename internal_map_type::size_type;
+
+    void clear() { m_map.clear(); }
+    bool empty() const { return m_map.empty(); }
+    size_type size() const { return m_map.size(); }
+    bool insert(const value_type &value) { return m_map.insert(value).second; }
+    bool insert_or_assign(const Key &k, const Val &v) { return m_map.insert_or_assign(k, v).second; }
+    size_type erase(const Key &k) { return m_map.erase(k); }
+    void swap(RawStdMap &other) { m_map.swap(other.m_map); }
+    void merge(RawStdMap &other) { m_map.merge(other.m_map); }
+    void merge(internal_map_type &other) { m_map.merge(other); }
+    Val at(const Key &k) const { return m_map.at(k); }
+    Val &operator[](const Key &k) { return m_map[k]; }
+    size_type count(const Key &k) const { return m_map.count(k); }
+    std::optional<Val> find(const Key &k) const {
+      auto const it = m_map.find(k);
+      if (it == m_map.end()) return std::nullopt;
+      return it->second;
+    }
+    internal_map_type data() const { return m_map; }
+    float load_factor() const { return m_map.load_factor(); }
+    float max_load_factor() const { return m_map.max_load_factor(); }
+    void max_load_factor(float ml) { m_map.max_load_factor(ml); }
+    void rehash(size_type count) { m_map.rehash(count); }
+    void reserve(size_type count) { m_map.reserve(count); }
+
+  private:
+    internal_map_type m_map{};
+  };
+
+  // Baseline adapter: std::unordered_map under a single std::mutex, the
+  // obvious hand-rolled alternative to this library. Every operation —
+  // reads included — takes the exclusive lock, which is exactly the cost
+  // the shared_mutex and sharded maps exist to avoid.
+  template <typename Key, typename Val>
+  class StdMutexMap {
+  public:
+    using internal_map_type = std::unordered_map<Key, Val>;
+    using key_type          = typename internal_map_type::key_type;
+    using mapped_type       = typename internal_map_type::mapped_type;
+    using value_type        = typename internal_map_type::value_type;
+    using size_type         = typename internal_map_type::size_type;
+
+    StdMutexMap() = default;
+    StdMutexMap(StdMutexMap &&other) {
+      std::scoped_lock lock(m_mutex, other.m_mutex);
+      m_map = std::move(other.m_map);
+    }
+    StdMutexMap &operator=(StdMutexMap &&other) {
+      std::scoped_lock lock(m_mutex, other.m_mutex);
+      m_map = std::move(other.m_map);
+      return *this;
+    }
+
+    void clear() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_map.clear();
+    }
+    bool empty() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map.empty();
+    }
+    size_type size() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map.size();
+    }
+    bool insert(const value_type &value) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map.insert(value).second;
+    }
+    bool insert_or_assign(const Key &k, const Val &v) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map.insert_or_assign(k, v).second;
+    }
+    size_type erase(const Key &k) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map.erase(k);
+    }
+    void swap(StdMutexMap &other) {
+      std::scoped_lock lock(m_mutex, other.m_mutex);
+      m_map.swap(other.m_map);
+    }
+    void merge(StdMutexMap &other) {
+      std::scoped_lock lock(m_mutex, other.m_mutex);
+      m_map.merge(other.m_map);
+    }
+    void merge(internal_map_type &other) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_map.merge(other);
+    }
+    Val at(const Key &k) const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map.at(k);
+    }
+    Val operator[](const Key &k) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map[k];
+    }
+    size_type count(const Key &k) const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map.count(k);
+    }
+    std::optional<Val> find(const Key &k) const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto const it = m_map.find(k);
+      if (it == m_map.end()) return std::nullopt;
+      return it->second;
+    }
+    internal_map_type data() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map;
+    }
+    float load_factor() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map.load_factor();
+    }
+    float max_load_factor() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_map.max_load_factor();
+    }
+    void max_load_factor(float ml) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_map.max_load_factor(ml);
+    }
+    void rehash(size_type count) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_map.rehash(count);
+    }
+    void reserve(size_type count) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_map.reserve(count);
+    }
+
+  private:
+    internal_map_type m_map{};
+    mutable std::mutex m_mutex{};
+  };
+
+} // namespace Benchmark
 
 template <typename>
 struct is_sharded : std::false_type {};
@@ -20,6 +180,18 @@ struct is_sharded<::concurrency::ShardedUnorderedMap<Key, Val>> : std::true_type
 template <typename Key, typename Val, uint32_t ShardCount>
 struct is_sharded<::concurrency::ShardedUnorderedMap<Key, Val, ShardCount>> : std::true_type {};
 
+template <typename>
+struct is_raw_baseline : std::false_type {};
+
+template <typename Key, typename Val>
+struct is_raw_baseline<::Benchmark::RawStdMap<Key, Val>> : std::true_type {};
+
+template <typename>
+struct is_mutex_baseline : std::false_type {};
+
+template <typename Key, typename Val>
+struct is_mutex_baseline<::Benchmark::StdMutexMap<Key, Val>> : std::true_type {};
+
 template <typename T>
 struct TypeParseTraits;
 
@@ -52,15 +224,28 @@ struct TypeParseTraits;
     if constexpr (is_sharded<map_type>::value) {                                                                          \
       r.map_type    = "Sharded";                                                                                          \
       r.shard_count = std::to_string(test_map.shard_count());                                                             \
+    } else if constexpr (is_raw_baseline<map_type>::value) {                                                              \
+      r.map_type    = "RawStdMap";                                                                                        \
+      r.shard_count = "N/A";                                                                                              \
+    } else if constexpr (is_mutex_baseline<map_type>::value) {                                                            \
+      r.map_type    = "StdMutexMap";                                                                                      \
+      r.shard_count = "N/A";                                                                                              \
     } else {                                                                                                              \
       r.map_type    = "Unsharded";                                                                                        \
       r.shard_count = "N/A";                                                                                              \
     }                                                                                                                     \
-    r.key_type              = TypeParseTraits<typename map_type::key_type>::name;                                         \
-    r.val_type              = TypeParseTraits<typename map_type::mapped_type>::name;                                      \
-    r.total_operations      = total_iterations;                                                                           \
-    r.total_elapsed_ms      = ::Benchmark::bench(bfunc, iterations);                                                      \
-    r.avg_operations_per_ms = total_iterations / static_cast<double>(r.total_elapsed_ms.count());                         \
+    /* The raw baseline is unsynchronized, so it gets a single thread. */                                                 \
+    uint32_t const bench_threads = is_raw_baseline<map_type>::value ? 1 : std::thread::hardware_concurrency();            \
+    r.thread_count               = bench_threads;                                                                         \
+    r.key_type                   = TypeParseTraits<typename map_type::key_type>::name;                                    \
+    r.val_type                   = TypeParseTraits<typename map_type::mapped_type>::name;                                 \
+    r.total_operations           = total_iterations;                                                                      \
+    auto const timing            = ::Benchmark::bench(bfunc, iterations, bench_threads);                                  \
+    r.repetitions                = timing.repetitions;                                                                    \
+    r.median_elapsed_ns          = timing.median;                                                                         \
+    r.min_elapsed_ns             = timing.min;                                                                            \
+    r.stddev_elapsed_ns          = timing.stddev;                                                                         \
+    r.avg_operations_per_ms      = total_iterations * 1e6 / static_cast<double>(std::max<int64_t>(timing.median.count(), 1)); \
     return r;                                                                                                             \
   }
 
@@ -87,29 +272,82 @@ struct TypeParseTraits;
 
 namespace Benchmark {
 
+  // Timing summary for one benchmark: statistics over the timed
+  // repetitions, in nanoseconds so sub-millisecond operations are not
+  // rounded to zero. The spread between min and median (and the stddev)
+  // is the noise floor — a regression smaller than it is not
+  // distinguishable from scheduling jitter.
+  struct Timing {
+    ::std::chrono::nanoseconds median{0};
+    ::std::chrono::nanoseconds min{0};
+    ::std::chrono::nanoseconds stddev{0};
+    uint32_t repetitions{0};
+  };
+
+  // Times f across thread_count threads. One untimed warmup pass
+  // populates caches and the branch predictor, then the workload is
+  // repeated and per-repetition wall times are summarized in the
+  // returned Timing. Each pass creates its threads first and parks them
+  // on a start flag; the clock starts only once every thread has checked
+  // in, so thread creation and scheduling costs stay outside the timed
+  // region.
   template <typename Functor>
-  std::chrono::milliseconds bench(Functor &&f, uint64_t const iterations = default_benchmark_iterations) {
+  Timing bench(Functor &&f, uint64_t const iterations = default_benchmark_iterations, uint32_t const thread_count = std::thread::hardware_concurrency(),
+               uint64_t const warmup_iterations = default_benchmark_warmup_iterations, uint32_t const repetitions = default_benchmark_repetitions) {
     using ::std::chrono::duration_cast;
+    using ::std::chrono::nanoseconds;
     using ::std::chrono::steady_clock;
 
-    std::atomic_uint64_t itr = 0;
+    auto run_once = [&f, thread_count](uint64_t const iters) -> nanoseconds {
+      std::atomic_uint64_t itr   = 0;
+      std::atomic_uint32_t ready = 0;
+      std::atomic_bool go        = false;
+
+      std::vector<std::thread> threads;
+      auto thread_func = [&itr, &ready, &go, &iters](Functor &&f) -> void {
+        ready.fetch_add(1);
+        while (!go.load(std::memory_order_acquire)) {}
+        for ((void) itr; itr < iters; ++itr) {
+          f();
+        }
+      };
 
-    std::vector<std::thread> threads;
-    auto thread_func = [&itr, &iterations](Functor &&f) -> void {
-      for ((void) itr; itr < iterations; ++itr) {
-        f();
+      for (uint32_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back(thread_func, f);
       }
+      while (ready.load() < thread_count) {}
+      auto const start = steady_clock::now();
+      go.store(true, std::memory_order_release);
+
+      for (auto &t: threads) {
+        t.join();
+      }
+      return duration_cast<nanoseconds>(steady_clock::now() - start);
     };
 
-    auto start = steady_clock::now();
-    for (uint32_t i = 0; i < std::thread::hardware_concurrency(); ++i) {
-      threads.emplace_back(thread_func, f);
+    if (warmup_iterations > 0) {
+      (void) run_once(warmup_iterations);
     }
 
-    for (auto &t: threads) {
-      t.join();
+    std::vector<nanoseconds> samples;
+    samples.reserve(std::max(repetitions, 1u));
+    for (uint32_t rep = 0; rep < std::max(repetitions, 1u); ++rep) {
+      samples.push_back(run_once(iterations));
     }
-    return duration_cast<::std::chrono::milliseconds>(steady_clock::now() - start);
+    std::sort(samples.begin(), samples.end());
+
+    Timing t;
+    t.repetitions   = static_cast<uint32_t>(samples.size());
+    t.min           = samples.front();
+    auto const mid  = samples.size() / 2;
+    t.median        = samples.size() % 2 ? samples[mid] : (samples[mid - 1] + samples[mid]) / 2;
+    double mean     = 0;
+    for (auto const s: samples) mean += static_cast<double>(s.count());
+    mean = mean / static_cast<double>(samples.size());
+    double var = 0;
+    for (auto const s: samples) var += (static_cast<double>(s.count()) - mean) * (static_cast<double>(s.count()) - mean);
+    t.stddev = nanoseconds(static_cast<int64_t>(std::sqrt(var / static_cast<double>(samples.size()))));
+    return t;
   }
 
   struct Result {
@@ -119,9 +357,16 @@ namespace Benchmark {
     ::std::string val_type{};
     ::std::string shard_count{};
     uint64_t total_operations{};
+    uint32_t repetitions{};
     double avg_operations_per_ms{};
-    ::std::chrono::milliseconds total_elapsed_ms{};
+    ::std::chrono::nanoseconds median_elapsed_ns{};
+    ::std::chrono::nanoseconds min_elapsed_ns{};
+    ::std::chrono::nanoseconds stddev_elapsed_ns{};
     uint32_t thread_count{std::thread::hardware_concurrency()};
+    // Throughput relative to the StdMutexMap baseline row for the same
+    // operation/key/value combination; filled in by results_to_csv, "N/A"
+    // when no baseline row is present.
+    ::std::string speedup_vs_mutex_map{"N/A"};
 
     static std::string csv_header();
     std::string csv_row() const;
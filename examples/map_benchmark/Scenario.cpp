@@ -0,0 +1,26 @@
+#include <Scenario.h>
+
+namespace Benchmark {
+
+  std::string ScenarioResult::csv_header() {
+    return "scenario,map_type,shard_count,distribution,thread_count,total_operations,total_ops_per_ms,min_thread_ops_per_ms,max_thread_ops_per_ms,p50_latency_ns,p99_"
+           "latency_ns\n";
+  }
+
+  std::string ScenarioResult::csv_row() const {
+    std::stringstream s;
+    s << scenario << "," << map_type << "," << shard_count << "," << distribution << "," << thread_count << "," << total_operations << "," << total_ops_per_ms << ","
+      << min_thread_ops_per_ms << "," << max_thread_ops_per_ms << "," << p50_latency_ns << "," << p99_latency_ns << "\n";
+    return s.str();
+  }
+
+  std::string ScenarioResult::results_to_csv(std::vector<ScenarioResult> const &results) {
+    std::stringstream s;
+    s << ScenarioResult::csv_header();
+    for (auto const &r: results) {
+      s << r.csv_row();
+    }
+    return s.str();
+  }
+
+} // namespace Benchmark
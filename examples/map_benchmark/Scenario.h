@@ -0,0 +1,166 @@
+#ifndef BENCHMARK_SCENARIO
+#define BENCHMARK_SCENARIO
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Benchmark {
+
+  // How keys are drawn from the key space. Uniform spreads load evenly
+  // across shards; Zipfian concentrates it on a few hot keys, which is
+  // what most production caches actually see.
+  enum class KeyDistribution { Uniform, Zipfian };
+
+  // Describes a mixed-operation workload. Operation percentages are
+  // expressed out of 100; whatever find_pct and insert_or_assign_pct do
+  // not cover is spent on erase.
+  struct ScenarioConfig {
+    std::string name{};
+    uint32_t thread_count{std::thread::hardware_concurrency()};
+    uint64_t key_space{100'000};
+    uint64_t ops_per_thread{1'000'000};
+    uint32_t find_pct{90};
+    uint32_t insert_or_assign_pct{10};
+    KeyDistribution distribution{KeyDistribution::Uniform};
+    double zipf_exponent{0.99};
+  };
+
+  struct ScenarioResult {
+    std::string scenario{};
+    std::string map_type{};
+    std::string shard_count{};
+    std::string distribution{};
+    uint32_t thread_count{};
+    uint64_t total_operations{};
+    double total_ops_per_ms{};
+    double min_thread_ops_per_ms{};
+    double max_thread_ops_per_ms{};
+    uint64_t p50_latency_ns{};
+    uint64_t p99_latency_ns{};
+
+    static std::string csv_header();
+    std::string csv_row() const;
+    static std::string results_to_csv(std::vector<ScenarioResult> const &results);
+  };
+
+  namespace detail {
+    // Cumulative distribution over [0, key_space) with probability
+    // proportional to 1/(rank+1)^s. Shared read-only across threads.
+    inline std::vector<double> zipf_cdf(uint64_t const key_space, double const s) {
+      std::vector<double> cdf(key_space);
+      double sum = 0;
+      for (uint64_t i = 0; i < key_space; ++i) {
+        sum += 1.0 / std::pow(static_cast<double>(i + 1), s);
+        cdf[i] = sum;
+      }
+      for (auto &c: cdf) {
+        c /= sum;
+      }
+      return cdf;
+    }
+  } // namespace detail
+
+  // Runs the described workload against the provided map and reports
+  // aggregate and per-thread throughput along with sampled operation
+  // latencies. Threads are created and the key distribution prepared
+  // before the timed region begins.
+  template <typename map_type>
+  ScenarioResult run_scenario(map_type &test_map, ScenarioConfig const &cfg) {
+    using clock = std::chrono::steady_clock;
+
+    std::vector<double> cdf;
+    if (cfg.distribution == KeyDistribution::Zipfian) {
+      cdf = detail::zipf_cdf(cfg.key_space, cfg.zipf_exponent);
+    }
+
+    // Sampling every operation's latency would dominate the run; record
+    // every latency_sample_stride'th operation instead.
+    constexpr uint64_t latency_sample_stride = 64;
+
+    std::vector<std::vector<uint64_t>> latency_samples(cfg.thread_count);
+    std::vector<double> thread_ops_per_ms(cfg.thread_count, 0.0);
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> go{false};
+
+    auto thread_func = [&](uint32_t const tid) {
+      std::mt19937_64 rng(tid + 1);
+      std::uniform_real_distribution<double> unit(0.0, 1.0);
+      std::uniform_int_distribution<uint64_t> uniform_key(0, cfg.key_space - 1);
+      auto &samples = latency_samples[tid];
+      samples.reserve(cfg.ops_per_thread / latency_sample_stride + 1);
+
+      ready.fetch_add(1);
+      while (!go.load(std::memory_order_acquire)) {}
+
+      auto const start = clock::now();
+      for (uint64_t op = 0; op < cfg.ops_per_thread; ++op) {
+        uint64_t key = 0;
+        if (cfg.distribution == KeyDistribution::Zipfian) {
+          key = static_cast<uint64_t>(std::lower_bound(cdf.begin(), cdf.end(), unit(rng)) - cdf.begin());
+        } else {
+          key = uniform_key(rng);
+        }
+        uint32_t const op_pick    = static_cast<uint32_t>(unit(rng) * 100.0);
+        bool const sample_latency = (op % latency_sample_stride) == 0;
+        auto const op_start       = sample_latency ? clock::now() : clock::time_point{};
+        if (op_pick < cfg.find_pct) {
+          (void) test_map.find(key);
+        } else if (op_pick < cfg.find_pct + cfg.insert_or_assign_pct) {
+          (void) test_map.insert_or_assign(key, op);
+        } else {
+          (void) test_map.erase(key);
+        }
+        if (sample_latency) {
+          samples.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - op_start).count()));
+        }
+      }
+      auto const elapsed_ms   = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+      thread_ops_per_ms[tid]  = elapsed_ms > 0 ? cfg.ops_per_thread / elapsed_ms : 0;
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(cfg.thread_count);
+    for (uint32_t t = 0; t < cfg.thread_count; ++t) {
+      threads.emplace_back(thread_func, t);
+    }
+    while (ready.load() != cfg.thread_count) {}
+    auto const start = clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto &t: threads) {
+      t.join();
+    }
+    auto const total_elapsed_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    ScenarioResult r;
+    r.scenario         = cfg.name;
+    r.distribution     = cfg.distribution == KeyDistribution::Zipfian ? "zipfian" : "uniform";
+    r.thread_count     = cfg.thread_count;
+    r.total_operations = cfg.ops_per_thread * cfg.thread_count;
+    r.total_ops_per_ms = total_elapsed_ms > 0 ? r.total_operations / total_elapsed_ms : 0;
+    auto const [min_it, max_it] = std::minmax_element(thread_ops_per_ms.begin(), thread_ops_per_ms.end());
+    r.min_thread_ops_per_ms     = *min_it;
+    r.max_thread_ops_per_ms     = *max_it;
+
+    std::vector<uint64_t> all_samples;
+    for (auto const &s: latency_samples) {
+      all_samples.insert(all_samples.end(), s.begin(), s.end());
+    }
+    if (!all_samples.empty()) {
+      std::sort(all_samples.begin(), all_samples.end());
+      r.p50_latency_ns = all_samples[all_samples.size() / 2];
+      r.p99_latency_ns = all_samples[std::min(all_samples.size() - 1, all_samples.size() * 99 / 100)];
+    }
+    return r;
+  }
+
+} // namespace Benchmark
+
+#endif // BENCHMARK_SCENARIO
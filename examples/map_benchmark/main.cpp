@@ -6,6 +6,8 @@
 #include <type_traits>
 #include <vector>
 
+using ::Benchmark::RawStdMap;
+using ::Benchmark::StdMutexMap;
 using ::concurrency::ShardedUnorderedMap;
 using ::concurrency::UnorderedMap;
 
@@ -160,68 +162,130 @@ REGISTER_BENCHMARK(reserve, 1, [&test_map]() { test_map.reserve(setup_test_map_s
 int main() {
   UnorderedMap<int, int> m1;
   ShardedUnorderedMap<int, int> m2;
+  RawStdMap<int, int> m3;
+  StdMutexMap<int, int> m4;
   std::vector<::Benchmark::Result> results;
 
   results.push_back(INVOKE_BENCHMARK(default_constructor, m1, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(default_constructor, m2, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(default_constructor, m3, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(default_constructor, m4, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(empty_when_empty, m1, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(empty_when_empty, m2, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(empty_when_empty, m3, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(empty_when_empty, m4, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(empty_when_not_empty, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(empty_when_not_empty, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(empty_when_not_empty, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(empty_when_not_empty, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(size_when_empty, m1, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(size_when_empty, m2, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(size_when_empty, m3, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(size_when_empty, m4, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(size, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(size, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(size, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(size, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(clear_when_empty, m1, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(clear_when_empty, m2, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(clear_when_empty, m3, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(clear_when_empty, m4, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(clear, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(clear, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(clear, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(clear, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(insert_when_empty, m1, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(insert_when_empty, m2, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(insert_when_empty, m3, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(insert_when_empty, m4, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(insert_when_key_exists, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(insert_when_key_exists, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(insert_when_key_exists, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(insert_when_key_exists, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(insert_or_assign_existing, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(insert_or_assign_existing, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(insert_or_assign_existing, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(insert_or_assign_existing, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(insert_or_assign_not_existing, m1, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(insert_or_assign_not_existing, m2, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(insert_or_assign_not_existing, m3, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(insert_or_assign_not_existing, m4, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(erase_existing, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(erase_existing, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(erase_existing, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(erase_existing, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(erase_not_existing, m1, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(erase_not_existing, m2, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(erase_not_existing, m3, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(erase_not_existing, m4, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(swap_with_empty, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(swap_with_empty, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(swap_with_empty, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(swap_with_empty, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(merge_with_empty, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(merge_with_empty, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(merge_with_empty, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(merge_with_empty, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(merge_with_empty_internal_map_type, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(merge_with_empty_internal_map_type, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(merge_with_empty_internal_map_type, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(merge_with_empty_internal_map_type, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(swap, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(swap, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(swap, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(swap, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(merge, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(merge, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(merge, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(merge, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(merge_with_internal_map_type, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(merge_with_internal_map_type, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(merge_with_internal_map_type, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(merge_with_internal_map_type, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(at, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(at, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(at, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(at, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(subscript_operator_not_existing, m1, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(subscript_operator_not_existing, m2, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(subscript_operator_not_existing, m3, void_func, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(subscript_operator_not_existing, m4, void_func, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(subscript_operator_existing, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(subscript_operator_existing, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(subscript_operator_existing, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(subscript_operator_existing, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(count, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(count, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(count, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(count, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(find, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(find, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(find, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(find, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(data, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(data, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(data, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(data, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(load_factor, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(load_factor, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(load_factor, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(load_factor, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(get_max_load_factor, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(get_max_load_factor, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(get_max_load_factor, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(get_max_load_factor, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(set_max_load_factor, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(set_max_load_factor, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(set_max_load_factor, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(set_max_load_factor, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(rehash, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(rehash, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(rehash, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(rehash, m4, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(reserve, m1, setup_test_map, teardown_test_map));
   results.push_back(INVOKE_BENCHMARK(reserve, m2, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(reserve, m3, setup_test_map, teardown_test_map));
+  results.push_back(INVOKE_BENCHMARK(reserve, m4, setup_test_map, teardown_test_map));
 
   std::cout << ::Benchmark::Result::results_to_csv(results);
   return EXIT_SUCCESS;
@@ -0,0 +1,96 @@
+#include <Benchmark.h>
+#include <Scenario.h>
+#include <concurrency/ShardedUnorderedMap.hpp>
+#include <concurrency/UnorderedMap.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using ::concurrency::ShardedUnorderedMap;
+using ::concurrency::UnorderedMap;
+
+namespace {
+
+  // Keep the per-run cost modest so the full sweep finishes in minutes;
+  // bump these when hunting for a production ShardCount.
+  constexpr uint64_t ops_per_thread = 200'000;
+  constexpr uint64_t key_space      = 100'000;
+
+  template <typename map_type>
+  void run_mix_sweep(std::string const &mix_name, uint32_t const find_pct, uint32_t const upsert_pct, std::vector<::Benchmark::ScenarioResult> &results) {
+    for (auto const distribution: {::Benchmark::KeyDistribution::Uniform, ::Benchmark::KeyDistribution::Zipfian}) {
+      for (uint32_t threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
+        map_type m;
+        // Pre-populate half the key space so finds hit roughly 50% of the time.
+        for (uint64_t i = 0; i < key_space / 2; ++i) {
+          (void) m.insert_or_assign(i, i);
+        }
+        ::Benchmark::ScenarioConfig cfg;
+        cfg.name                 = mix_name;
+        cfg.thread_count         = threads;
+        cfg.key_space            = key_space;
+        cfg.ops_per_thread       = ops_per_thread;
+        cfg.find_pct             = find_pct;
+        cfg.insert_or_assign_pct = upsert_pct;
+        cfg.distribution         = distribution;
+
+        auto r = ::Benchmark::run_scenario(m, cfg);
+        if constexpr (is_sharded<map_type>::value) {
+          r.map_type    = "Sharded";
+          r.shard_count = std::to_string(m.shard_count());
+        } else {
+          r.map_type    = "Unsharded";
+          r.shard_count = "N/A";
+        }
+        results.push_back(r);
+      }
+    }
+  }
+
+  // Write-only hammering of a tiny key space, per ShardCount. With only a
+  // few hot keys, neighboring shards' locks are taken constantly from
+  // different cores, which is exactly the access pattern where false
+  // sharing between adjacent shards shows up; compare builds with and
+  // without the AlignedShard padding to see its effect, and compare
+  // ShardCounts to judge whether the padding's memory cost is justified.
+  template <typename map_type>
+  void run_contended_write_sweep(std::vector<::Benchmark::ScenarioResult> &results) {
+    for (uint32_t threads = 2; threads <= std::thread::hardware_concurrency() * 2; threads *= 2) {
+      map_type m;
+      ::Benchmark::ScenarioConfig cfg;
+      cfg.name                 = "contended_write_hot_keys";
+      cfg.thread_count         = threads;
+      cfg.key_space            = 1024; // Small on purpose; nearly every op contends.
+      cfg.ops_per_thread       = ops_per_thread;
+      cfg.find_pct             = 0;
+      cfg.insert_or_assign_pct = 100;
+      cfg.distribution         = ::Benchmark::KeyDistribution::Uniform;
+
+      auto r        = ::Benchmark::run_scenario(m, cfg);
+      r.map_type    = "Sharded";
+      r.shard_count = std::to_string(m.shard_count());
+      results.push_back(r);
+    }
+  }
+
+} // anonymous namespace
+
+int main() {
+  std::vector<::Benchmark::ScenarioResult> results;
+
+  // The mixes we care about: read-mostly (the common cache profile),
+  // balanced, and write-only churn.
+  for (auto const &[name, find_pct, upsert_pct]: {std::tuple<std::string, uint32_t, uint32_t>{"read_mostly_90_10", 90, 10}, //
+                                                  std::tuple<std::string, uint32_t, uint32_t>{"balanced_50_50", 50, 50},    //
+                                                  std::tuple<std::string, uint32_t, uint32_t>{"write_churn_0_80", 0, 80}}) {
+    run_mix_sweep<UnorderedMap<uint64_t, uint64_t>>(name, find_pct, upsert_pct, results);
+    run_mix_sweep<ShardedUnorderedMap<uint64_t, uint64_t>>(name, find_pct, upsert_pct, results);
+  }
+
+  run_contended_write_sweep<ShardedUnorderedMap<uint64_t, uint64_t, 8>>(results);
+  run_contended_write_sweep<ShardedUnorderedMap<uint64_t, uint64_t, 32>>(results);
+  run_contended_write_sweep<ShardedUnorderedMap<uint64_t, uint64_t, 128>>(results);
+
+  std::cout << ::Benchmark::ScenarioResult::results_to_csv(results);
+  return EXIT_SUCCESS;
+}
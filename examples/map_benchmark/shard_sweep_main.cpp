@@ -0,0 +1,105 @@
+#include <Scenario.h>
+#include <concurrency/ShardedUnorderedMap.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using ::concurrency::ShardedUnorderedMap;
+
+// Sweeps ShardCount across powers of two under a contended mixed
+// workload and emits a CSV matrix of throughput by (ShardCount, thread
+// count), plus a closing row naming the best ShardCount per thread
+// count. Each count is a distinct template instantiation, so the sweep
+// is unrolled at compile time; run this on a new machine type to pick a
+// ShardCount on evidence rather than folklore (and to revisit
+// DefaultUnorderedMapShardCount).
+namespace {
+
+  // Keep the per-cell cost modest so the full matrix finishes in
+  // minutes; bump these when tuning for production.
+  constexpr uint64_t ops_per_thread = 200'000;
+  // Small enough that shard locks genuinely contend at high thread
+  // counts, large enough that the maps do real hashing work.
+  constexpr uint64_t key_space = 4096;
+
+  std::vector<uint32_t> sweep_thread_counts() {
+    std::vector<uint32_t> counts;
+    for (uint32_t n = 1; n <= std::thread::hardware_concurrency() * 2; n *= 2) {
+      counts.push_back(n);
+    }
+    return counts;
+  }
+
+  // One matrix row: the given ShardCount at every thread count.
+  template <uint32_t ShardCount>
+  std::pair<uint32_t, std::vector<double>> run_shard_count(std::vector<uint32_t> const &thread_counts) {
+    std::vector<double> row;
+    row.reserve(thread_counts.size());
+    for (auto const threads: thread_counts) {
+      ShardedUnorderedMap<int, int, ShardCount> m;
+      // Pre-populate half the key space so finds hit roughly 50% of the time.
+      for (uint64_t i = 0; i < key_space / 2; ++i) {
+        (void) m.insert_or_assign(static_cast<int>(i), static_cast<int>(i));
+      }
+      ::Benchmark::ScenarioConfig cfg;
+      cfg.name                 = "shard_count_sweep";
+      cfg.thread_count         = threads;
+      cfg.key_space            = key_space;
+      cfg.ops_per_thread       = ops_per_thread;
+      cfg.find_pct             = 50;
+      cfg.insert_or_assign_pct = 40; // Remaining 10% is erase.
+      cfg.distribution         = ::Benchmark::KeyDistribution::Uniform;
+      row.push_back(::Benchmark::run_scenario(m, cfg).total_ops_per_ms);
+    }
+    return {ShardCount, std::move(row)};
+  }
+
+  template <uint32_t... ShardCounts>
+  std::vector<std::pair<uint32_t, std::vector<double>>> run_sweep(std::vector<uint32_t> const &thread_counts) {
+    std::vector<std::pair<uint32_t, std::vector<double>>> rows;
+    rows.reserve(sizeof...(ShardCounts));
+    (rows.push_back(run_shard_count<ShardCounts>(thread_counts)), ...);
+    return rows;
+  }
+
+} // anonymous namespace
+
+int main() {
+  auto const thread_counts = sweep_thread_counts();
+  auto const rows          = run_sweep<1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024>(thread_counts);
+
+  std::stringstream out;
+  out << "shard_count";
+  for (auto const t: thread_counts) {
+    out << ",threads_" << t;
+  }
+  out << "\n";
+  for (auto const &[shard_count, row]: rows) {
+    out << shard_count;
+    for (auto const ops_per_ms: row) {
+      out << "," << ops_per_ms;
+    }
+    out << "\n";
+  }
+
+  // Closing row: the ShardCount with the highest throughput per column.
+  out << "best_shard_count";
+  for (size_t col = 0; col < thread_counts.size(); ++col) {
+    uint32_t best  = 0;
+    double best_v = -1.0;
+    for (auto const &[shard_count, row]: rows) {
+      if (row[col] > best_v) {
+        best_v = row[col];
+        best   = shard_count;
+      }
+    }
+    out << "," << best;
+  }
+  out << "\n";
+
+  std::cout << out.str();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,220 @@
+#ifndef ASYNC_SHARDED_UNORDERED_CONCURRENT_MAP
+#define ASYNC_SHARDED_UNORDERED_CONCURRENT_MAP
+
+#include <concurrency/ShardedUnorderedMap.hpp>
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace concurrency {
+
+  // An asynchronous facade over ShardedUnorderedMap for callers — event
+  // loops in particular — that must never block on a contended lock.
+  // Every async_* function enqueues the operation on the owning shard's
+  // queue and immediately returns a std::future for its result; a small
+  // worker pool drains the queues. A shard's queue is only ever drained
+  // by one worker at a time, so operations on the same shard run
+  // back-to-back with uncontended lock acquisitions and in FIFO order
+  // (an async_at enqueued after an async_insert_or_assign for the same
+  // key observes the new value), while operations on different shards
+  // proceed in parallel across workers.
+  //
+  // Exceptions thrown by an operation (e.g. std::out_of_range from
+  // async_at on an absent key) are captured and rethrown from the
+  // future's get().
+  //
+  // The facade owns its map. Synchronous access to the full
+  // ShardedUnorderedMap interface is available through map(), but mixing
+  // synchronous writes with in-flight async operations forfeits the
+  // per-shard FIFO ordering guarantee for the keys involved. All async_*
+  // functions are safe to call concurrently from any number of threads.
+  // The destructor drains every operation already enqueued before
+  // returning; enqueueing from another thread while the facade is being
+  // destroyed is undefined behavior, as with any standard container.
+  template <class Key, class Val, uint32_t ShardCount = DefaultUnorderedMapShardCount, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Val>>,
+            class StatsPolicy = NullUnorderedMapStatsPolicy, class Backend = NodeBackend, class FilterPolicy = NullUnorderedMapFilterPolicy>
+  class AsyncShardedUnorderedMap {
+  public:
+    // ------------------------------ Member types ------------------------------ //
+    using self_type  = AsyncShardedUnorderedMap<Key, Val, ShardCount, Hash, Pred, Allocator, StatsPolicy, Backend, FilterPolicy>;
+    using map_type   = ShardedUnorderedMap<Key, Val, ShardCount, Hash, Pred, Allocator, StatsPolicy, Backend, FilterPolicy>;
+    using key_type   = typename map_type::key_type;
+    using mapped_type = typename map_type::mapped_type;
+    using value_type = typename map_type::value_type;
+    using size_type  = typename map_type::size_type;
+
+    // The default pool size; deliberately small, since workers only burn
+    // CPU while queues are non-empty and a handful is enough to keep
+    // several shards draining in parallel.
+    static uint32_t default_worker_count() { return std::clamp(std::thread::hardware_concurrency() / 4, 1u, 8u); }
+
+    // ------------------------------ Constructors ------------------------------ //
+    explicit AsyncShardedUnorderedMap(uint32_t const worker_count = default_worker_count()) {
+      uint32_t const n = std::max(worker_count, 1u);
+      m_workers.reserve(n);
+      for (uint32_t i = 0; i < n; ++i) {
+        m_workers.emplace_back([this]() { worker_loop(); });
+      }
+    }
+
+    AsyncShardedUnorderedMap(const AsyncShardedUnorderedMap &) = delete;
+    AsyncShardedUnorderedMap &operator=(const AsyncShardedUnorderedMap &) = delete;
+
+    ~AsyncShardedUnorderedMap() {
+      {
+        std::lock_guard<std::mutex> lock(m_ready_mutex);
+        m_stop = true;
+      }
+      m_ready_cv.notify_all();
+      for (auto &w: m_workers) {
+        w.join();
+      }
+    }
+
+    // ------------------------- Asynchronous operations ------------------------ //
+    // Each mirrors the ShardedUnorderedMap function of the same name
+    // minus the async_ prefix; see that class for semantics.
+
+    std::future<Val> async_at(const Key &key) {
+      return submit<Val>(key, [this, key]() { return m_map.at(key); });
+    }
+
+    std::future<bool> async_find(const Key &key) {
+      return submit<bool>(key, [this, key]() { return m_map.find(key); });
+    }
+
+    std::future<bool> async_insert(value_type value) {
+      return submit<bool>(value.first, [this, value = std::move(value)]() mutable { return m_map.insert(std::move(value)); });
+    }
+
+    std::future<bool> async_insert_or_assign(Key key, Val val) {
+      return submit<bool>(key, [this, key, val = std::move(val)]() mutable { return m_map.insert_or_assign(key, std::move(val)); });
+    }
+
+    std::future<size_type> async_erase(Key key) {
+      return submit<size_type>(key, [this, key = std::move(key)]() { return m_map.erase(key); });
+    }
+
+    // The callable is invoked by a worker under the shard's write lock;
+    // see UnorderedMap::visit. It must not touch this facade or its map,
+    // which would self-deadlock.
+    template <class F>
+    std::future<bool> async_visit(Key key, F &&f) {
+      return submit<bool>(key, [this, key = std::move(key), fn = std::forward<F>(f)]() mutable { return m_map.visit(key, std::move(fn)); });
+    }
+
+    std::future<Val> async_fetch_add(Key key, Val delta) {
+      return submit<Val>(key, [this, key = std::move(key), delta = std::move(delta)]() { return m_map.fetch_add(key, delta); });
+    }
+
+    // ------------------------------- Observers -------------------------------- //
+    // The underlying map, for synchronous use; see the class comment for
+    // the ordering caveat when mixed with in-flight async operations.
+    map_type       &map() noexcept { return m_map; }
+    const map_type &map() const noexcept { return m_map; }
+
+    uint32_t worker_count() const noexcept { return static_cast<uint32_t>(m_workers.size()); }
+
+  private:
+    using op_type = std::function<void()>;
+
+    // A shard's pending operations. The active flag is true while the
+    // shard is either waiting in m_ready or being drained by a worker,
+    // which is what keeps a shard on a single worker at a time.
+    struct ShardQueue {
+      std::mutex mutex{};
+      std::deque<op_type> ops{};
+      bool active{false};
+    };
+
+    map_type m_map{};
+    std::array<ShardQueue, ShardCount> m_queues{};
+
+    std::mutex m_ready_mutex{};
+    std::condition_variable m_ready_cv{};
+    std::deque<uint32_t> m_ready{};
+    bool m_stop{false};
+    std::vector<std::thread> m_workers{};
+
+    // Wraps the operation so its result or exception lands in a promise,
+    // and enqueues it on the owning shard. The promise is held by
+    // shared_ptr because std::function requires copyable targets.
+    template <class R, class F>
+    std::future<R> submit(const Key &key, F &&f) {
+      auto promise = std::make_shared<std::promise<R>>();
+      auto future  = promise->get_future();
+      enqueue(m_map.shard_idx(key), [promise = std::move(promise), fn = std::forward<F>(f)]() mutable {
+        try {
+          promise->set_value(fn());
+        } catch (...) {
+          promise->set_exception(std::current_exception());
+        }
+      });
+      return future;
+    }
+
+    void enqueue(uint32_t const idx, op_type op) {
+      auto &q = m_queues[idx];
+      {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.ops.push_back(std::move(op));
+        if (q.active) return; // Already in m_ready or being drained; the owner will pick this op up.
+        q.active = true;
+      }
+      {
+        std::lock_guard<std::mutex> lock(m_ready_mutex);
+        m_ready.push_back(idx);
+      }
+      m_ready_cv.notify_one();
+    }
+
+    void worker_loop() {
+      for (;;) {
+        uint32_t idx = 0;
+        {
+          std::unique_lock<std::mutex> lock(m_ready_mutex);
+          m_ready_cv.wait(lock, [this]() { return m_stop || !m_ready.empty(); });
+          // Stop only once every ready shard is drained, so the
+          // destructor never abandons an enqueued operation.
+          if (m_ready.empty()) return;
+          idx = m_ready.front();
+          m_ready.pop_front();
+        }
+        drain(idx);
+      }
+    }
+
+    // Executes the shard's pending operations, batch by batch, until the
+    // queue is observed empty, at which point the shard goes inactive and
+    // the next enqueue re-schedules it.
+    void drain(uint32_t const idx) {
+      auto &q = m_queues[idx];
+      for (;;) {
+        std::deque<op_type> batch;
+        {
+          std::lock_guard<std::mutex> lock(q.mutex);
+          if (q.ops.empty()) {
+            q.active = false;
+            return;
+          }
+          batch.swap(q.ops);
+        }
+        for (auto &op: batch) {
+          op();
+        }
+      }
+    }
+  };
+
+} // namespace concurrency
+#endif // ASYNC_SHARDED_UNORDERED_CONCURRENT_MAP
@@ -0,0 +1,622 @@
+#ifndef DYNAMIC_SHARDED_UNORDERED_CONCURRENT_MAP
+#define DYNAMIC_SHARDED_UNORDERED_CONCURRENT_MAP
+
+#include <concurrency/ShardedUnorderedMap.hpp>
+#include <concurrency/UnorderedMap.hpp>
+#include <stdexcept>
+
+namespace concurrency {
+
+  // This class provides the same sharded, thread-safe, unordered map as
+  // ShardedUnorderedMap, but takes its shard count at construction time
+  // instead of as a template parameter. That lets one binary tune shard
+  // counts per deployment and pass differently sharded maps through a
+  // single type — at the cost of the compile-time constant-folding (and
+  // power-of-two strength reduction) the template version enjoys on the
+  // shard-index modulo. When the shard count is known at compile time,
+  // prefer ShardedUnorderedMap.
+  //
+  // The shard implementation is shared with ShardedUnorderedMap: each
+  // shard is an UnorderedMap guarding its slice of the key space.
+  //
+  // https://en.cppreference.com/w/cpp/container/unordered_map
+  template <class Key, class Val, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Val>>,
+            class StatsPolicy = NullUnorderedMapStatsPolicy, class Backend = NodeBackend, class FilterPolicy = NullUnorderedMapFilterPolicy>
+  class DynamicShardedUnorderedMap {
+  public:
+    // ------------------------------ Member types ------------------------------ //
+    using self_type            = DynamicShardedUnorderedMap<Key, Val, Hash, Pred, Allocator, StatsPolicy, Backend, FilterPolicy>;
+    using shard_type           = UnorderedMap<Key, Val, Hash, Pred, Allocator, StatsPolicy, Backend, FilterPolicy>;
+    using internal_map_type    = typename shard_type::internal_map_type;
+    using key_type             = typename shard_type::key_type;
+    using mapped_type          = typename shard_type::mapped_type;
+    using value_type           = typename shard_type::value_type;
+    using size_type            = typename shard_type::size_type;
+    using difference_type      = typename shard_type::difference_type;
+    using hasher               = typename shard_type::hasher;
+    using key_equal            = typename shard_type::key_equal;
+    using allocator_type       = typename shard_type::allocator_type;
+    using reference            = typename shard_type::reference;
+    using const_reference      = typename shard_type::const_reference;
+    using pointer              = typename shard_type::pointer;
+    using const_pointer        = typename shard_type::const_pointer;
+    using iterator             = typename shard_type::iterator;
+    using const_iterator       = typename shard_type::const_iterator;
+    using local_iterator       = typename shard_type::local_iterator;
+    using const_local_iterator = typename shard_type::const_local_iterator;
+    using node_type            = typename shard_type::node_type;
+
+    // ------------------------------ Constructors ------------------------------ //
+    // Throws std::invalid_argument if shard_count is zero.
+    explicit DynamicShardedUnorderedMap(uint32_t const shard_count = DefaultUnorderedMapShardCount) : m_shards(validate_shard_count(shard_count)) {}
+    DynamicShardedUnorderedMap(const DynamicShardedUnorderedMap &other) = default;
+    DynamicShardedUnorderedMap(DynamicShardedUnorderedMap &&other)      = default;
+    DynamicShardedUnorderedMap(std::initializer_list<value_type> ilist) : m_shards(DefaultUnorderedMapShardCount) { insert(ilist); }
+
+    DynamicShardedUnorderedMap &operator=(const DynamicShardedUnorderedMap &other)     = default;
+    DynamicShardedUnorderedMap &operator=(DynamicShardedUnorderedMap &&other) noexcept = default;
+    DynamicShardedUnorderedMap &operator=(std::initializer_list<value_type> ilist) {
+      this->clear();
+      this->insert(ilist);
+      return *this;
+    }
+
+    ~DynamicShardedUnorderedMap() = default;
+
+    allocator_type get_allocator() const { return m_shards.at(0).get_allocator(); }
+
+    // -------------------------------- Capacity -------------------------------- //
+    bool empty() const noexcept {
+      for (auto &s: m_shards) {
+        if (!s.empty()) return false;
+      }
+      return true;
+    }
+
+    size_type size() const noexcept {
+      size_type size = 0;
+      for (auto &s: m_shards) {
+        size += s.size();
+      }
+      return size;
+    }
+
+    // Lock-free approximate element count; see
+    // ShardedUnorderedMap::approx_size.
+    size_type approx_size() const noexcept {
+      size_type size = 0;
+      for (auto &s: m_shards) {
+        size += s.approx_size();
+      }
+      return size;
+    }
+
+    // Lock-free counterpart to empty(), subject to
+    // the same caveat as approx_size().
+    bool approx_empty() const noexcept {
+      for (auto &s: m_shards) {
+        if (!s.approx_empty()) return false;
+      }
+      return true;
+    }
+
+    // ------------------------------- Modifiers -------------------------------- //
+
+    void clear() noexcept {
+      for (auto &s: m_shards) {
+        s.clear();
+      }
+    }
+
+    bool insert(const value_type &value) { return get_mutable_shard(value.first).insert(value); }
+    bool insert(value_type &&value) { return get_mutable_shard(value.first).insert(std::move(value)); }
+    void insert(std::initializer_list<value_type> ilist) {
+      for (auto const &el: ilist) {
+        (void) insert(el);
+      }
+    }
+    bool insert(node_type &&nh) { return get_mutable_shard(nh.key()).insert(std::move(nh)); }
+
+    // Batched insert; see ShardedUnorderedMap::insert_batch.
+    template <class InputIt>
+    size_type insert_batch(InputIt first, InputIt last) {
+      std::vector<std::vector<value_type>> partitioned(m_shards.size());
+      for (auto it = first; it != last; ++it) {
+        partitioned[get_shard_idx(it->first)].push_back(*it);
+      }
+      size_type inserted = 0;
+      for (size_t i = 0; i < m_shards.size(); ++i) {
+        if (partitioned[i].empty()) continue;
+        inserted += m_shards[i].insert_batch(partitioned[i].begin(), partitioned[i].end());
+      }
+      return inserted;
+    }
+    // Inserts all elements of the provided vector. See insert_batch(InputIt, InputIt).
+    size_type insert_batch(std::vector<value_type> const &values) { return insert_batch(values.begin(), values.end()); }
+
+    template <class M>
+    bool insert_or_assign(const Key &k, M &&obj) {
+      return get_mutable_shard(k).insert_or_assign(k, std::forward<M>(obj));
+    }
+    template <class M>
+    bool insert_or_assign(Key &&k, M &&obj) {
+      return get_mutable_shard(k).insert_or_assign(std::move(k), std::forward<M>(obj));
+    }
+
+    // Move-assigns over the element mapped to the provided key, in
+    // place. Returns false without inserting if the key is absent. See
+    // UnorderedMap::assign.
+    bool assign(const Key &key, Val &&val) { return get_mutable_shard(key).assign(key, std::move(val)); }
+
+    // Constructs a value_type from the provided arguments, then moves it
+    // into the owning shard. See ShardedUnorderedMap::emplace.
+    template <class... Args>
+    bool emplace(Args &&...args) {
+      value_type value(std::forward<Args>(args)...);
+      return get_mutable_shard(value.first).emplace(std::move(value));
+    }
+
+    template <class... Args>
+    bool try_emplace(const Key &k, Args &&...args) {
+      return get_mutable_shard(k).try_emplace(k, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    bool try_emplace(Key &&k, Args &&...args) {
+      return get_mutable_shard(k).try_emplace(std::move(k), std::forward<Args>(args)...);
+    }
+
+    size_type erase(const Key &key) { return get_mutable_shard(key).erase(key); }
+
+    // Heterogeneous counterpart to erase(); see UnorderedMap::erase.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    size_type erase(K const &key) {
+      return get_mutable_shard(key).erase(key);
+    }
+
+    // Predicate-driven bulk erase, one write lock per shard; see
+    // UnorderedMap::erase_if.
+    template <class P>
+    size_type erase_if(P &&pred) {
+      size_type erased = 0;
+      for (auto &s: m_shards) {
+        erased += s.erase_if(pred);
+      }
+      return erased;
+    }
+
+    // Swaps shard arrays wholesale. The two maps may have different
+    // shard counts; each keeps the other's count afterward.
+    //
+    // NOT thread-safe, unlike every other member and unlike
+    // ShardedUnorderedMap::swap(self_type &): the shard vectors
+    // themselves are exchanged, which no per-shard lock can protect, and
+    // guarding them with a map-wide lock would funnel every operation on
+    // every shard through a single cache line — defeating the point of
+    // sharding. As with std::unordered_map::swap, the caller must ensure
+    // exclusive access to both maps for the duration of the call.
+    void swap(self_type &other) noexcept { this->m_shards.swap(other.m_shards); }
+
+    void swap(internal_map_type &other) noexcept {
+      internal_map_type tmp = other;
+      other.clear();
+      for (auto &s: m_shards) {
+        other.merge(s.data());
+      }
+      this->clear();
+      for (auto const &el: tmp) {
+        this->insert(el);
+      }
+    }
+
+    node_type extract(const Key &k) { return get_mutable_shard(k).extract(k); }
+
+    void merge(internal_map_type &source) {
+      auto tmp = source;
+      for (auto const &el: tmp) {
+        if (find(el.first)) continue;
+        (void) insert(std::move(source.extract(el.first)));
+      }
+    }
+    void merge(internal_map_type &&source) {
+      auto tmp = source;
+      for (auto const &el: tmp) {
+        if (find(el.first)) continue;
+        (void) insert(std::move(source.extract(el.first)));
+      }
+    }
+    void merge(std::unordered_multimap<Key, Val, Hash, Pred, Allocator> &source) {
+      auto tmp = source;
+      for (auto const &el: tmp) {
+        if (find(el.first)) continue;
+        (void) insert(std::move(source.extract(el.first)));
+      }
+    }
+    void merge(std::unordered_multimap<Key, Val, Hash, Pred, Allocator> &&source) {
+      auto tmp = source;
+      for (auto const &el: tmp) {
+        if (find(el.first)) continue;
+        (void) insert(std::move(source.extract(el.first)));
+      }
+    }
+    void merge(shard_type &source) {
+      for (auto const &el: source.data()) {
+        if (find(el.first)) continue;
+        (void) insert(std::move(source.extract(el.first)));
+      }
+    }
+    void merge(shard_type &&source) {
+      for (auto const &el: source.data()) {
+        if (find(el.first)) continue;
+        (void) insert(std::move(source.extract(el.first)));
+      }
+    }
+    void merge(self_type &source) {
+      for (auto const &el: source.data()) {
+        if (find(el.first)) continue;
+        (void) insert(std::move(source.extract(el.first)));
+      }
+    }
+    void merge(self_type &&source) {
+      for (auto const &el: source.data()) {
+        if (find(el.first)) continue;
+        (void) insert(std::move(source.extract(el.first)));
+      }
+    }
+
+    // ------------------------------ Accessors --------------------------------- //
+    // Returns a copy of the element mapped to
+    // the provided key. Does bounds checking.
+    Val at(const Key &key) const { return get_shard(key).at(key); }
+    // Returns a copy of the element mapped to
+    // the provided key. Does bounds checking.
+    Val at(const Key &&key) const { return get_shard(key).at(key); }
+
+    // Heterogeneous counterpart to at(); see ShardedUnorderedMap::at.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    Val at(K const &key) const {
+      return get_shard(key).at(key);
+    }
+
+    // Single-lock lookup-or-construct; see UnorderedMap::get_or_insert.
+    template <class F>
+    Val get_or_insert(const Key &key, F &&factory) {
+      return get_mutable_shard(key).get_or_insert(key, std::forward<F>(factory));
+    }
+
+    // Returns a copy of the element mapped to
+    // the provided key. If no element is present,
+    // a new one is default constructed.
+    Val operator[](const Key &key) { return get_mutable_shard(key)[key]; }
+    // Returns a copy of the element mapped to
+    // the provided key. If no element is present,
+    // a new one is default constructed.
+    Val operator[](Key &&key) { return get_mutable_shard(key)[key]; }
+
+    // Zero-copy read access; see UnorderedMap::cvisit.
+    template <class F>
+    bool cvisit(const Key &key, F &&f) const {
+      return get_shard(key).cvisit(key, std::forward<F>(f));
+    }
+
+    // Zero-copy in-place write access; see UnorderedMap::visit.
+    template <class F>
+    bool visit(const Key &key, F &&f) {
+      return get_mutable_shard(key).visit(key, std::forward<F>(f));
+    }
+
+    // Single-lock atomic counter increment; see UnorderedMap::fetch_add.
+    Val fetch_add(const Key &key, Val const &delta) { return get_mutable_shard(key).fetch_add(key, delta); }
+
+    // In-place iteration under one shard read lock at a time; see
+    // ShardedUnorderedMap::for_each.
+    template <class F>
+    void for_each(F &&f) const {
+      for (auto &s: m_shards) {
+        s.for_each(f);
+      }
+    }
+
+    // As for_each(F &&), but dispatches shards across the requested
+    // number of threads; see ShardedUnorderedMap::for_each.
+    template <class F>
+    void for_each(F &&f, uint32_t const thread_count) const {
+      uint32_t const threads_to_use = std::min<uint32_t>(thread_count == 0 ? 1 : thread_count, static_cast<uint32_t>(m_shards.size()));
+      std::vector<std::thread> threads;
+      threads.reserve(threads_to_use);
+      for (uint32_t t = 0; t < threads_to_use; ++t) {
+        threads.emplace_back([this, &f, t, threads_to_use]() {
+          for (size_t i = t; i < m_shards.size(); i += threads_to_use) {
+            m_shards[i].for_each(f);
+          }
+        });
+      }
+      for (auto &t: threads) {
+        t.join();
+      }
+    }
+
+    // Per-shard access; see ShardedUnorderedMap::for_each_shard.
+    template <class F>
+    void for_each_shard(F &&f) const {
+      for (uint32_t i = 0; i < m_shards.size(); ++i) {
+        f(i, m_shards[i]);
+      }
+    }
+
+    size_type count(const Key &key) const { return get_shard(key).count(key); }
+
+    // Heterogeneous counterpart to count(); see UnorderedMap::count.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    size_type count(K const &key) const {
+      return get_shard(key).count(key);
+    }
+
+    // Predicate-counting across all shards; see UnorderedMap::count_if.
+    template <class P>
+    size_type count_if(P &&pred) const {
+      size_type count = 0;
+      for (auto &s: m_shards) {
+        count += s.count_if(pred);
+      }
+      return count;
+    }
+
+    // True if any element in any shard satisfies the predicate; see
+    // UnorderedMap::any_of.
+    template <class P>
+    bool any_of(P &&pred) const {
+      for (auto &s: m_shards) {
+        if (s.any_of(pred)) return true;
+      }
+      return false;
+    }
+
+    // Returns a bool indicating whether or not the
+    // provided key is present in the map.
+    bool find(const Key &key) const { return get_shard(key).find(key); }
+
+    // Heterogeneous counterpart to find(); see UnorderedMap::find.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    bool find(K const &key) const {
+      return get_shard(key).find(key);
+    }
+
+    // Shard-grouped batch lookup; see ShardedUnorderedMap::find_many.
+    std::vector<std::optional<Val>> find_many(std::vector<Key> const &keys) const {
+      std::vector<std::optional<Val>> results(keys.size());
+      std::vector<std::vector<size_t>> partitioned(m_shards.size());
+      for (size_t i = 0; i < keys.size(); ++i) {
+        partitioned[get_shard_idx(keys[i])].push_back(i);
+      }
+      for (size_t s = 0; s < m_shards.size(); ++s) {
+        if (partitioned[s].empty()) continue;
+        std::vector<Key> shard_keys;
+        shard_keys.reserve(partitioned[s].size());
+        for (auto const i: partitioned[s]) {
+          shard_keys.push_back(keys[i]);
+        }
+        std::vector<std::optional<Val>> shard_results;
+        shard_results.reserve(shard_keys.size());
+        (void) m_shards[s].find_many(shard_keys.begin(), shard_keys.end(), std::back_inserter(shard_results));
+        for (size_t j = 0; j < partitioned[s].size(); ++j) {
+          results[partitioned[s][j]] = std::move(shard_results[j]);
+        }
+      }
+      return results;
+    }
+
+    // Returns a copy of the data in each
+    // shard as a single non-thread-safe unordered_map.
+    internal_map_type data() const {
+      internal_map_type m;
+      for (auto &s: m_shards) {
+        m.merge(s.data());
+      }
+      return m;
+    }
+
+    // Incremental per-shard export; see ShardedUnorderedMap::snapshot.
+    template <class F>
+    size_type snapshot(F &&f) const {
+      size_type streamed = 0;
+      for (uint32_t i = 0; i < m_shards.size(); ++i) {
+        internal_map_type shard_data = m_shards[i].data();
+        streamed += shard_data.size();
+        f(i, std::move(shard_data));
+      }
+      return streamed;
+    }
+
+    // ------------------------------ Hash Policy ------------------------------- //
+    uint32_t shard_count() const noexcept { return static_cast<uint32_t>(m_shards.size()); }
+
+    // Averaged load factor across all shards.
+    float load_factor() const {
+      float lf = 0;
+      for (auto &s: m_shards) {
+        lf += s.load_factor();
+      }
+      return lf / m_shards.size();
+    }
+
+    // Returns the load factor for a given shard.
+    // If shard_idx is greater than the number of shards,
+    // -1.0 is returned.
+    float shard_load_factor(uint32_t const shard_idx) const {
+      if (shard_idx >= m_shards.size()) {
+        return -1.0;
+      }
+      return m_shards.at(shard_idx).load_factor();
+    }
+
+    // Summed bucket count across all shards.
+    size_type bucket_count() const {
+      size_type count = 0;
+      for (auto &s: m_shards) {
+        count += s.bucket_count();
+      }
+      return count;
+    }
+
+    // Single-shard bucket count; see
+    // ShardedUnorderedMap::shard_bucket_count.
+    size_type shard_bucket_count(uint32_t const shard_idx) const { return m_shards.at(shard_idx).bucket_count(); }
+
+    // Estimated whole-map byte footprint; see
+    // ShardedUnorderedMap::memory_usage.
+    size_type memory_usage() const {
+      size_type bytes = 0;
+      for (auto &s: m_shards) {
+        bytes += s.memory_usage();
+      }
+      return bytes;
+    }
+
+    // Estimated single-shard byte footprint; see
+    // ShardedUnorderedMap::shard_memory_usage.
+    size_type shard_memory_usage(uint32_t const shard_idx) const { return m_shards.at(shard_idx).memory_usage(); }
+
+    // Per-shard instrumentation snapshot; see
+    // ShardedUnorderedMap::shard_stats.
+    UnorderedMapStats shard_stats(uint32_t const shard_idx) const { return m_shards.at(shard_idx).stats(); }
+
+    // Cross-shard counter aggregation; see
+    // ShardedUnorderedMap::stats_summary.
+    ShardedUnorderedMapStatsSummary stats_summary() const {
+      ShardedUnorderedMapStatsSummary summary;
+      std::vector<double> ops;
+      std::vector<double> elements;
+      ops.reserve(m_shards.size());
+      elements.reserve(m_shards.size());
+      for (auto &s: m_shards) {
+        auto const st = s.stats();
+        summary.total_read_ops += st.read_lock_acquisitions;
+        summary.total_write_ops += st.write_lock_acquisitions;
+        summary.total_read_lock_wait += st.read_lock_wait;
+        summary.total_write_lock_wait += st.write_lock_wait;
+        ops.push_back(static_cast<double>(st.read_lock_acquisitions + st.write_lock_acquisitions));
+        elements.push_back(static_cast<double>(st.element_count));
+      }
+      auto const moments = [](std::vector<double> const &v, double &mean, double &stddev) {
+        mean = 0;
+        for (auto const x: v) mean += x;
+        mean       = mean / v.size();
+        double var = 0;
+        for (auto const x: v) var += (x - mean) * (x - mean);
+        stddev = std::sqrt(var / v.size());
+      };
+      summary.min_shard_ops      = static_cast<uint64_t>(*std::min_element(ops.begin(), ops.end()));
+      summary.max_shard_ops      = static_cast<uint64_t>(*std::max_element(ops.begin(), ops.end()));
+      summary.min_shard_elements = static_cast<size_t>(*std::min_element(elements.begin(), elements.end()));
+      summary.max_shard_elements = static_cast<size_t>(*std::max_element(elements.begin(), elements.end()));
+      moments(ops, summary.mean_shard_ops, summary.stddev_shard_ops);
+      moments(elements, summary.mean_shard_elements, summary.stddev_shard_elements);
+      return summary;
+    }
+
+    // Returns the current maximum load factor
+    // allowed for all shards.
+    float max_load_factor() const { return m_shards.at(0).max_load_factor(); }
+
+    // Sets the maximum load factor allowed
+    // for all shards.
+    void max_load_factor(float ml) {
+      for (auto &s: m_shards) {
+        s.max_load_factor(ml);
+      }
+    }
+
+    // For each shard, reserves at least the specified number of buckets
+    // and regenerates the hash table.
+    void rehash(size_type count) {
+      for (auto &s: m_shards) {
+        s.rehash(count);
+      }
+    }
+
+    // For each shard, reserves space for at least the specified number of
+    // elements and regenerates the hash table.
+    void reserve(size_type count) {
+      for (auto &s: m_shards) {
+        s.reserve(count);
+      }
+    }
+
+    // Whole-map capacity pre-sizing; see ShardedUnorderedMap::reserve_total.
+    void reserve_total(size_type expected_total_elements) {
+      for (auto &s: m_shards) {
+        s.reserve(per_shard_capacity(expected_total_elements));
+      }
+    }
+
+    // Whole-map bucket pre-sizing; see ShardedUnorderedMap::rehash_total.
+    void rehash_total(size_type expected_total_buckets) {
+      for (auto &s: m_shards) {
+        s.rehash(per_shard_capacity(expected_total_buckets));
+      }
+    }
+
+    // ------------------------------- Observers -------------------------------- //
+    hasher hash_function() const { return m_hash; }
+
+    key_equal key_eq() const { return m_shards.at(0).key_eq(); }
+
+  private:
+    std::vector<internal::AlignedShard<shard_type>> m_shards;
+    hasher m_hash{};
+
+    static uint32_t validate_shard_count(uint32_t const shard_count) {
+      if (shard_count == 0) {
+        throw std::invalid_argument("DynamicShardedUnorderedMap shard count must be non-zero.");
+      }
+      return shard_count;
+    }
+
+    // Splits a whole-map capacity estimate across shards, padded by 1/8th
+    // to absorb shard skew from imperfect key distribution.
+    size_type per_shard_capacity(size_type const total) const {
+      size_type const per_shard = (total + m_shards.size() - 1) / m_shards.size();
+      return per_shard + per_shard / 8;
+    }
+
+    // Derives a shard index from the key's hash; the remix rationale is
+    // the same as ShardedUnorderedMap::get_shard_idx. Templated so
+    // transparent hashers route heterogeneous probes without
+    // materializing a Key.
+    template <class K>
+    uint32_t get_shard_idx(K const &key) const {
+      size_t h = m_hash(key);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<uint32_t>(h % m_shards.size());
+    }
+    template <class K>
+    shard_type &get_mutable_shard(K const &key) {
+      return m_shards[get_shard_idx(key)];
+    }
+    template <class K>
+    const shard_type &get_shard(K const &key) const {
+      return m_shards[get_shard_idx(key)];
+    }
+  };
+
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator==(const ::concurrency::DynamicShardedUnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::DynamicShardedUnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &rhs) {
+    return lhs.data() == rhs.data();
+  }
+
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator!=(const ::concurrency::DynamicShardedUnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::DynamicShardedUnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &rhs) {
+    return !(lhs == rhs);
+  }
+
+  // Specializes the std::swap algorithm for ::concurrency::DynamicShardedUnorderedMap. Swaps the contents of lhs and rhs. Calls lhs.swap(rhs),
+  // which requires exclusive access to both maps; see DynamicShardedUnorderedMap::swap(self_type &).
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  void swap(::concurrency::DynamicShardedUnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, ::concurrency::DynamicShardedUnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+} // namespace concurrency
+#endif // DYNAMIC_SHARDED_UNORDERED_CONCURRENT_MAP
@@ -0,0 +1,310 @@
+#ifndef EXPIRING_SHARDED_UNORDERED_CONCURRENT_MAP
+#define EXPIRING_SHARDED_UNORDERED_CONCURRENT_MAP
+
+#include <concurrency/ShardedUnorderedMap.hpp>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace concurrency {
+
+  // Sharded, thread-safe map whose entries carry a deadline and expire
+  // automatically. Built for session/cache workloads that would otherwise
+  // layer (Val, deadline) pairs on top of ShardedUnorderedMap and pay for
+  // periodic whole-map copy-scan-erase sweeps.
+  //
+  // Expiry is lazy: read paths (find/at/count/ttl) treat expired entries
+  // as absent without reclaiming them, write paths (insert/insert_or_assign/
+  // erase/touch) reclaim any expired entry they land on, and sweep() walks
+  // a bounded number of buckets per shard per call so stale entries whose
+  // keys are never touched again can be reclaimed incrementally — e.g.
+  // from a background thread — without ever scanning a whole shard.
+  //
+  // Deadlines use std::chrono::steady_clock, so they are immune to wall
+  // clock adjustments. Entries inserted without an explicit TTL use the
+  // default TTL given at construction.
+  //
+  // This class intentionally exposes a smaller surface than the other
+  // maps in this library; functions that do not exist for
+  // std::unordered_map are documented with comments.
+  template <class Key, class Val, uint32_t ShardCount = DefaultUnorderedMapShardCount, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
+            class Allocator = std::allocator<std::pair<const Key, Val>>>
+  class ExpiringShardedUnorderedMap {
+  public:
+    // ------------------------------ Member types ------------------------------ //
+    using self_type   = ExpiringShardedUnorderedMap<Key, Val, ShardCount, Hash, Pred, Allocator>;
+    using key_type    = Key;
+    using mapped_type = Val;
+    using value_type  = std::pair<const Key, Val>;
+    using size_type   = size_t;
+    using hasher      = Hash;
+    using key_equal   = Pred;
+    using clock       = std::chrono::steady_clock;
+    using duration    = clock::duration;
+    using time_point  = clock::time_point;
+
+    // ------------------------------ Constructors ------------------------------ //
+    // Entries inserted without an explicit TTL expire default_ttl after
+    // insertion (or after the most recent touch()).
+    explicit ExpiringShardedUnorderedMap(duration const default_ttl) : m_default_ttl(default_ttl) { validate_shard_count(); }
+
+    ExpiringShardedUnorderedMap(const ExpiringShardedUnorderedMap &other) : m_default_ttl(other.m_default_ttl) {
+      validate_shard_count();
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        std::shared_lock<std::shared_mutex> lock(other.m_shards[i].mtx);
+        m_shards[i].map          = other.m_shards[i].map;
+        m_shards[i].sweep_cursor = other.m_shards[i].sweep_cursor;
+      }
+    }
+
+    ExpiringShardedUnorderedMap &operator=(const ExpiringShardedUnorderedMap &other) {
+      m_default_ttl = other.m_default_ttl;
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        std::shared_lock<std::shared_mutex> other_lock(other.m_shards[i].mtx);
+        std::unique_lock<std::shared_mutex> lock(m_shards[i].mtx);
+        m_shards[i].map          = other.m_shards[i].map;
+        m_shards[i].sweep_cursor = other.m_shards[i].sweep_cursor;
+      }
+      return *this;
+    }
+
+    ~ExpiringShardedUnorderedMap() = default;
+
+    // -------------------------------- Capacity -------------------------------- //
+    // Counts only live (unexpired) entries; expired-but-unreclaimed
+    // entries are invisible here, consistent with find().
+    size_type size() const {
+      time_point const now = clock::now();
+      size_type n          = 0;
+      for (auto const &s: m_shards) {
+        std::shared_lock<std::shared_mutex> lock(s.mtx);
+        for (auto const &el: s.map) {
+          if (!expired(el.second, now)) ++n;
+        }
+      }
+      return n;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Number of entries physically stored, including expired ones not yet
+    // reclaimed by a write or a sweep. stored_size() - size() is the
+    // reclaimable backlog. This function does not exist for
+    // std::unordered_map.
+    size_type stored_size() const {
+      size_type n = 0;
+      for (auto const &s: m_shards) {
+        std::shared_lock<std::shared_mutex> lock(s.mtx);
+        n += s.map.size();
+      }
+      return n;
+    }
+
+    // ------------------------------- Modifiers -------------------------------- //
+    void clear() {
+      for (auto &s: m_shards) {
+        std::unique_lock<std::shared_mutex> lock(s.mtx);
+        s.map.clear();
+        s.sweep_cursor = 0;
+      }
+    }
+
+    // Returns true if the value was inserted. An expired entry under the
+    // same key does not block insertion; it is overwritten (reclaimed) in
+    // the same critical section.
+    bool insert(const Key &key, const Val &val) { return insert(key, val, m_default_ttl); }
+    bool insert(const Key &key, const Val &val, duration const ttl) {
+      auto &shard          = get_mutable_shard(key);
+      time_point const now = clock::now();
+      std::unique_lock<std::shared_mutex> lock(shard.mtx);
+      auto const it = shard.map.find(key);
+      if (it != shard.map.end()) {
+        if (!expired(it->second, now)) return false;
+        it->second = entry{val, now + ttl};
+        return true;
+      }
+      shard.map.emplace(key, entry{val, now + ttl});
+      return true;
+    }
+
+    // Returns true if the value was inserted (no live entry existed),
+    // false if a live entry's value was replaced. Either way the deadline
+    // is reset.
+    bool insert_or_assign(const Key &key, const Val &val) { return insert_or_assign(key, val, m_default_ttl); }
+    bool insert_or_assign(const Key &key, const Val &val, duration const ttl) {
+      auto &shard          = get_mutable_shard(key);
+      time_point const now = clock::now();
+      std::unique_lock<std::shared_mutex> lock(shard.mtx);
+      auto const it = shard.map.find(key);
+      if (it != shard.map.end()) {
+        bool const was_live = !expired(it->second, now);
+        it->second          = entry{val, now + ttl};
+        return !was_live;
+      }
+      shard.map.emplace(key, entry{val, now + ttl});
+      return true;
+    }
+
+    // Returns 1 only if a live entry was removed. An expired entry under
+    // the key is still reclaimed, but reported as absent (0).
+    size_type erase(const Key &key) {
+      auto &shard          = get_mutable_shard(key);
+      time_point const now = clock::now();
+      std::unique_lock<std::shared_mutex> lock(shard.mtx);
+      auto const it = shard.map.find(key);
+      if (it == shard.map.end()) return 0;
+      bool const was_live = !expired(it->second, now);
+      shard.map.erase(it);
+      return was_live ? 1 : 0;
+    }
+
+    // Pushes a live entry's deadline out to now + ttl (default TTL when
+    // omitted) without touching its value. Returns false — and reclaims
+    // the entry — if it has already expired. This function does not exist
+    // for std::unordered_map.
+    bool touch(const Key &key) { return touch(key, m_default_ttl); }
+    bool touch(const Key &key, duration const ttl) {
+      auto &shard          = get_mutable_shard(key);
+      time_point const now = clock::now();
+      std::unique_lock<std::shared_mutex> lock(shard.mtx);
+      auto const it = shard.map.find(key);
+      if (it == shard.map.end()) return false;
+      if (expired(it->second, now)) {
+        shard.map.erase(it);
+        return false;
+      }
+      it->second.deadline = now + ttl;
+      return true;
+    }
+
+    // Visits at most max_buckets_per_shard buckets in each shard, erasing
+    // every expired entry found, and remembers its position so successive
+    // calls cycle through whole shards incrementally. Intended to be
+    // called periodically (e.g. from a maintenance thread); each call
+    // holds any one shard's write lock only for the bounded scan, so it
+    // never introduces a whole-map latency spike. Returns the number of
+    // entries reclaimed. This function does not exist for
+    // std::unordered_map.
+    size_type sweep(size_type const max_buckets_per_shard = 64) {
+      time_point const now = clock::now();
+      size_type reclaimed  = 0;
+      for (auto &s: m_shards) {
+        std::unique_lock<std::shared_mutex> lock(s.mtx);
+        size_type const bc = s.map.bucket_count();
+        if (bc == 0 || s.map.empty()) continue;
+        size_type const to_visit = max_buckets_per_shard < bc ? max_buckets_per_shard : bc;
+        std::vector<Key> dead;
+        for (size_type visited = 0; visited < to_visit; ++visited) {
+          size_type const b = (s.sweep_cursor + visited) % bc;
+          for (auto it = s.map.begin(b); it != s.map.end(b); ++it) {
+            if (expired(it->second, now)) dead.push_back(it->first);
+          }
+        }
+        s.sweep_cursor = (s.sweep_cursor + to_visit) % bc;
+        for (auto const &k: dead) {
+          reclaimed += s.map.erase(k);
+        }
+      }
+      return reclaimed;
+    }
+
+    // ------------------------------ Accessors --------------------------------- //
+    // Returns a copy of the value if a live entry exists; expired entries
+    // are reported as absent (but left for a write or sweep to reclaim).
+    std::optional<Val> find(const Key &key) const {
+      auto const &shard    = get_shard(key);
+      time_point const now = clock::now();
+      std::shared_lock<std::shared_mutex> lock(shard.mtx);
+      auto const it = shard.map.find(key);
+      if (it == shard.map.end() || expired(it->second, now)) return std::nullopt;
+      return it->second.val;
+    }
+
+    Val at(const Key &key) const {
+      auto found = find(key);
+      if (!found) {
+        throw std::out_of_range("concurrency::ExpiringShardedUnorderedMap::at");
+      }
+      return *std::move(found);
+    }
+
+    size_type count(const Key &key) const { return find(key) ? 1 : 0; }
+
+    // Remaining time until the entry expires, or std::nullopt if there is
+    // no live entry. This function does not exist for std::unordered_map.
+    std::optional<duration> ttl(const Key &key) const {
+      auto const &shard    = get_shard(key);
+      time_point const now = clock::now();
+      std::shared_lock<std::shared_mutex> lock(shard.mtx);
+      auto const it = shard.map.find(key);
+      if (it == shard.map.end() || expired(it->second, now)) return std::nullopt;
+      return it->second.deadline - now;
+    }
+
+    // Returns a copy of all live entries as a non-thread-safe map. This
+    // function does not exist for std::unordered_map.
+    std::unordered_map<Key, Val, Hash, Pred, Allocator> data() const {
+      time_point const now = clock::now();
+      std::unordered_map<Key, Val, Hash, Pred, Allocator> ret;
+      for (auto const &s: m_shards) {
+        std::shared_lock<std::shared_mutex> lock(s.mtx);
+        for (auto const &el: s.map) {
+          if (!expired(el.second, now)) ret.emplace(el.first, el.second.val);
+        }
+      }
+      return ret;
+    }
+
+    // ------------------------------- Observers -------------------------------- //
+    hasher hash_function() const { return m_hash; }
+
+    duration default_ttl() const noexcept { return m_default_ttl; }
+
+  private:
+    struct entry {
+      Val val;
+      time_point deadline;
+    };
+
+    using entry_allocator   = typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const Key, entry>>;
+    using internal_map_type = std::unordered_map<Key, entry, Hash, Pred, entry_allocator>;
+
+    // Shards own their lock directly (rather than wrapping UnorderedMap)
+    // so expiry checks, reclamation, and deadline updates each happen in
+    // a single critical section. Aligned apart for the same false-sharing
+    // reason as internal::AlignedShard.
+    struct alignas(UnorderedMapShardAlignment) Shard {
+      mutable std::shared_mutex mtx{};
+      internal_map_type map{};
+      size_type sweep_cursor{0};
+    };
+
+    std::array<Shard, ShardCount> m_shards{};
+    hasher m_hash{};
+    duration m_default_ttl;
+
+    void validate_shard_count() const { static_assert(ShardCount != 0, "ShardCount template parameter must be non-zero."); }
+
+    static bool expired(entry const &e, time_point const now) noexcept { return e.deadline <= now; }
+
+    // Same remix as ShardedUnorderedMap::get_shard_idx; see the rationale
+    // there.
+    uint32_t get_shard_idx(Key const &key) const {
+      size_t h = m_hash(key);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<uint32_t>(h % ShardCount);
+    }
+    Shard &get_mutable_shard(Key const &key) { return m_shards[get_shard_idx(key)]; }
+    const Shard &get_shard(Key const &key) const { return m_shards[get_shard_idx(key)]; }
+  };
+
+} // namespace concurrency
+#endif // EXPIRING_SHARDED_UNORDERED_CONCURRENT_MAP
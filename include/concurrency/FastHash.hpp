@@ -0,0 +1,117 @@
+#ifndef CONCURRENT_MAP_FAST_HASH
+#define CONCURRENT_MAP_FAST_HASH
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace concurrency {
+
+  namespace internal {
+    // 128-bit multiply-fold (the "mum" primitive wyhash is built on):
+    // multiplies two 64-bit values and xors the high and low halves of
+    // the 128-bit product, diffusing every input bit across the result
+    // in a single multiply. Falls back to a murmur3-style finalizer on
+    // targets without a 128-bit integer type.
+    inline uint64_t fast_hash_mum(uint64_t const a, uint64_t const b) noexcept {
+#ifdef __SIZEOF_INT128__
+      __uint128_t const r = static_cast<__uint128_t>(a) * b;
+      return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+      uint64_t h = a ^ b;
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return h;
+#endif
+    }
+
+    inline uint64_t fast_hash_read64(unsigned char const *p) noexcept {
+      uint64_t v = 0;
+      std::memcpy(&v, p, sizeof(v));
+      return v;
+    }
+
+    // wyhash-style byte hasher: two mums per 16-byte block plus one for
+    // the tail, rather than the byte-at-a-time FNV loop std::hash uses
+    // for strings in some implementations.
+    inline uint64_t fast_hash_bytes(void const *data, size_t const len) noexcept {
+      constexpr uint64_t k0 = 0xa0761d6478bd642fULL;
+      constexpr uint64_t k1 = 0xe7037ed1a0b428dbULL;
+
+      auto const *p    = static_cast<unsigned char const *>(data);
+      uint64_t h       = k0 ^ len;
+      size_t remaining = len;
+      while (remaining >= 16) {
+        h = fast_hash_mum(fast_hash_read64(p) ^ k0, fast_hash_read64(p + 8) ^ h);
+        p += 16;
+        remaining -= 16;
+      }
+      uint64_t a = 0;
+      uint64_t b = 0;
+      if (remaining >= 8) {
+        a = fast_hash_read64(p);
+        p += 8;
+        remaining -= 8;
+      }
+      for (size_t i = 0; i < remaining; ++i) {
+        b = (b << 8) | p[i];
+      }
+      return fast_hash_mum(a ^ k1, b ^ h);
+    }
+  } // namespace internal
+
+  // High-throughput drop-in for the Hash template parameter of
+  // UnorderedMap, ShardedUnorderedMap, and DynamicShardedUnorderedMap.
+  // std::hash for integers is the identity function on most standard
+  // library implementations, which both feeds weak bits to the shard
+  // index remix and clusters sequential keys; fast_hash always runs the
+  // input through a multiply-fold mixer. The string specializations are
+  // transparent (they hash std::string, std::string_view, and const
+  // char * identically), enabling the maps' allocation-free
+  // heterogeneous lookup path.
+  template <class T, class Enable = void>
+  struct fast_hash;
+
+  template <class T>
+  struct fast_hash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>> {
+    size_t operator()(T const v) const noexcept { return static_cast<size_t>(internal::fast_hash_mum(static_cast<uint64_t>(v), 0x9e3779b97f4a7c15ULL)); }
+  };
+
+  template <class T>
+  struct fast_hash<T, std::enable_if_t<std::is_floating_point_v<T> && sizeof(T) <= sizeof(uint64_t)>> {
+    size_t operator()(T const v) const noexcept {
+      // Match std::hash in hashing 0.0 and -0.0 identically, as they
+      // compare equal.
+      uint64_t bits = 0;
+      if (v != static_cast<T>(0)) {
+        std::memcpy(&bits, &v, sizeof(v));
+      }
+      return static_cast<size_t>(internal::fast_hash_mum(bits, 0x9e3779b97f4a7c15ULL));
+    }
+  };
+
+  template <class T>
+  struct fast_hash<T *> {
+    size_t operator()(T *const p) const noexcept { return static_cast<size_t>(internal::fast_hash_mum(reinterpret_cast<uintptr_t>(p), 0x9e3779b97f4a7c15ULL)); }
+  };
+
+  template <>
+  struct fast_hash<std::string> {
+    using is_transparent = void;
+    size_t operator()(std::string_view const sv) const noexcept { return static_cast<size_t>(internal::fast_hash_bytes(sv.data(), sv.size())); }
+  };
+
+  template <>
+  struct fast_hash<std::string_view> {
+    using is_transparent = void;
+    size_t operator()(std::string_view const sv) const noexcept { return static_cast<size_t>(internal::fast_hash_bytes(sv.data(), sv.size())); }
+  };
+
+} // namespace concurrency
+#endif // CONCURRENT_MAP_FAST_HASH
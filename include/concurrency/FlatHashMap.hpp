@@ -0,0 +1,535 @@
+#ifndef CONCURRENT_MAP_FLAT_HASH_MAP
+#define CONCURRENT_MAP_FLAT_HASH_MAP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace concurrency {
+
+  // Open-addressing hash table with contiguous key/value slots and a
+  // separate one-byte-per-slot control array, intended as a drop-in
+  // backend for UnorderedMap via FlatBackend (see the Backend template
+  // parameter on the maps). Compared to std::unordered_map's
+  // node-per-element layout it trades per-element pointer stability —
+  // which the locked wrappers already do not expose, since everything
+  // returns copies — for roughly half the memory per entry and probes
+  // that walk a cache line of control bytes instead of chasing list
+  // nodes.
+  //
+  // Layout: power-of-two slot array probed linearly from the hash's low
+  // bits; each control byte is either empty (0xFF), a tombstone (0xFE),
+  // or the top seven bits of the element's hash, so most non-matching
+  // slots are rejected without touching the slot array at all.
+  //
+  // This container is NOT thread-safe; wrap it in UnorderedMap or the
+  // sharded maps. It implements the subset of the std::unordered_map
+  // interface those wrappers use, including a node-like extract/insert
+  // (which copies the key, as flat storage has no detachable nodes).
+  template <class Key, class Val, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Val>>>
+  class FlatHashMap {
+  public:
+    // ------------------------------ Member types ------------------------------ //
+    using key_type        = Key;
+    using mapped_type     = Val;
+    using value_type      = std::pair<const Key, Val>;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher          = Hash;
+    using key_equal       = Pred;
+    using allocator_type  = Allocator;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using pointer         = typename std::allocator_traits<Allocator>::pointer;
+    using const_pointer   = typename std::allocator_traits<Allocator>::const_pointer;
+
+  private:
+    static constexpr uint8_t k_ctrl_empty     = 0xFF;
+    static constexpr uint8_t k_ctrl_tombstone = 0xFE;
+    static constexpr size_type k_min_capacity = 8;
+    // Open addressing degrades sharply as the table fills; growth
+    // ignores any max_load_factor above this.
+    static constexpr float k_max_usable_load_factor = 0.875f;
+
+    template <bool IsConst>
+    class basic_iterator {
+      using table_ptr = std::conditional_t<IsConst, FlatHashMap const *, FlatHashMap *>;
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = FlatHashMap::value_type;
+      using difference_type   = std::ptrdiff_t;
+      using reference         = std::conditional_t<IsConst, value_type const &, value_type &>;
+      using pointer           = std::conditional_t<IsConst, value_type const *, value_type *>;
+
+      basic_iterator() = default;
+      // Non-const to const conversion.
+      template <bool C = IsConst, class = std::enable_if_t<C>>
+      basic_iterator(basic_iterator<false> const &other) : m_table(other.m_table), m_idx(other.m_idx) {}
+
+      reference operator*() const { return m_table->m_slots[m_idx]; }
+      pointer operator->() const { return m_table->m_slots + m_idx; }
+      basic_iterator &operator++() {
+        ++m_idx;
+        skip_to_full();
+        return *this;
+      }
+      basic_iterator operator++(int) {
+        basic_iterator ret = *this;
+        ++(*this);
+        return ret;
+      }
+      bool operator==(basic_iterator const &other) const { return m_table == other.m_table && m_idx == other.m_idx; }
+      bool operator!=(basic_iterator const &other) const { return !(*this == other); }
+
+    private:
+      friend class FlatHashMap;
+      basic_iterator(table_ptr table, size_type idx) : m_table(table), m_idx(idx) { skip_to_full(); }
+      void skip_to_full() {
+        while (m_idx < m_table->m_capacity && !FlatHashMap::is_full(m_table->m_ctrl[m_idx])) ++m_idx;
+      }
+      table_ptr m_table{nullptr};
+      size_type m_idx{0};
+    };
+
+  public:
+    using iterator             = basic_iterator<false>;
+    using const_iterator       = basic_iterator<true>;
+    using local_iterator       = iterator;
+    using const_local_iterator = const_iterator;
+
+    // Detached-element surrogate for std::unordered_map's node handle.
+    // Flat storage has no stable nodes to splice, so extraction moves the
+    // mapped value out but must copy the key.
+    class node_type {
+    public:
+      node_type()                      = default;
+      node_type(node_type &&)          = default;
+      node_type &operator=(node_type &&) = default;
+
+      bool empty() const noexcept { return !m_value.has_value(); }
+      explicit operator bool() const noexcept { return m_value.has_value(); }
+      key_type &key() const { return m_value->first; }
+      mapped_type &mapped() const { return m_value->second; }
+
+    private:
+      friend class FlatHashMap;
+      explicit node_type(std::pair<Key, Val> &&value) : m_value(std::move(value)) {}
+      mutable std::optional<std::pair<Key, Val>> m_value{};
+    };
+
+    struct insert_return_type {
+      iterator position{};
+      bool inserted{false};
+      node_type node{};
+    };
+
+    // ------------------------------ Constructors ------------------------------ //
+    FlatHashMap() = default;
+    explicit FlatHashMap(const Allocator &alloc) : m_alloc(alloc) {}
+    FlatHashMap(const FlatHashMap &other) : m_max_load_factor(other.m_max_load_factor), m_hash(other.m_hash), m_eq(other.m_eq), m_alloc(other.m_alloc) {
+      reserve(other.size());
+      for (auto const &el: other) {
+        (void) insert(el);
+      }
+    }
+    FlatHashMap(FlatHashMap &&other) noexcept { swap(other); }
+    FlatHashMap(std::initializer_list<value_type> ilist) { insert(ilist); }
+
+    FlatHashMap &operator=(const FlatHashMap &other) {
+      FlatHashMap tmp(other);
+      swap(tmp);
+      return *this;
+    }
+    FlatHashMap &operator=(FlatHashMap &&other) noexcept {
+      swap(other);
+      return *this;
+    }
+    FlatHashMap &operator=(std::initializer_list<value_type> ilist) {
+      clear();
+      insert(ilist);
+      return *this;
+    }
+
+    ~FlatHashMap() {
+      destroy_slots();
+      deallocate_arrays();
+    }
+
+    allocator_type get_allocator() const { return m_alloc; }
+
+    // ------------------------------- Iterators -------------------------------- //
+    iterator begin() noexcept { return iterator(this, 0); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(this, m_capacity); }
+    const_iterator end() const noexcept { return const_iterator(this, m_capacity); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // -------------------------------- Capacity -------------------------------- //
+    bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+    size_type max_size() const noexcept { return std::numeric_limits<size_type>::max() / sizeof(value_type) / 2; }
+
+    // ------------------------------- Modifiers -------------------------------- //
+    void clear() noexcept {
+      destroy_slots();
+      for (size_type i = 0; i < m_capacity; ++i) {
+        m_ctrl[i] = k_ctrl_empty;
+      }
+      m_size       = 0;
+      m_tombstones = 0;
+    }
+
+    std::pair<iterator, bool> insert(const value_type &value) { return emplace(value); }
+    std::pair<iterator, bool> insert(value_type &&value) { return emplace(std::move(value)); }
+    template <class P, class = std::enable_if_t<std::is_constructible_v<value_type, P &&>>>
+    std::pair<iterator, bool> insert(P &&value) {
+      return emplace(std::forward<P>(value));
+    }
+    void insert(std::initializer_list<value_type> ilist) {
+      for (auto const &el: ilist) {
+        (void) insert(el);
+      }
+    }
+    insert_return_type insert(node_type &&nh) {
+      if (nh.empty()) {
+        return {end(), false, {}};
+      }
+      auto const [it, inserted] = try_emplace(std::move(nh.m_value->first), std::move(nh.m_value->second));
+      if (inserted) {
+        return {it, true, {}};
+      }
+      return {it, false, std::move(nh)};
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const Key &k, M &&obj) {
+      auto const [idx, found] = locate_for_insert(k);
+      if (found) {
+        m_slots[idx].second = std::forward<M>(obj);
+        return {iterator(this, idx), false};
+      }
+      return {construct_at(idx, value_type(k, std::forward<M>(obj))), true};
+    }
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(Key &&k, M &&obj) {
+      auto const [idx, found] = locate_for_insert(k);
+      if (found) {
+        m_slots[idx].second = std::forward<M>(obj);
+        return {iterator(this, idx), false};
+      }
+      return {construct_at(idx, value_type(std::move(k), std::forward<M>(obj))), true};
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args &&...args) {
+      value_type value(std::forward<Args>(args)...);
+      auto const [idx, found] = locate_for_insert(value.first);
+      if (found) {
+        return {iterator(this, idx), false};
+      }
+      return {construct_at(idx, std::move(value)), true};
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const Key &k, Args &&...args) {
+      auto const [idx, found] = locate_for_insert(k);
+      if (found) {
+        return {iterator(this, idx), false};
+      }
+      return {construct_at(idx, value_type(std::piecewise_construct, std::forward_as_tuple(k), std::forward_as_tuple(std::forward<Args>(args)...))), true};
+    }
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(Key &&k, Args &&...args) {
+      auto const [idx, found] = locate_for_insert(k);
+      if (found) {
+        return {iterator(this, idx), false};
+      }
+      return {construct_at(idx, value_type(std::piecewise_construct, std::forward_as_tuple(std::move(k)), std::forward_as_tuple(std::forward<Args>(args)...))), true};
+    }
+
+    size_type erase(const Key &key) {
+      auto const [idx, found] = locate(key);
+      if (!found) return 0;
+      erase_at(idx);
+      return 1;
+    }
+    iterator erase(iterator pos) {
+      erase_at(pos.m_idx);
+      return iterator(this, pos.m_idx);
+    }
+    iterator erase(const_iterator pos) {
+      erase_at(pos.m_idx);
+      return iterator(this, pos.m_idx);
+    }
+
+    void swap(FlatHashMap &other) noexcept {
+      std::swap(m_slots, other.m_slots);
+      std::swap(m_ctrl, other.m_ctrl);
+      std::swap(m_capacity, other.m_capacity);
+      std::swap(m_size, other.m_size);
+      std::swap(m_tombstones, other.m_tombstones);
+      std::swap(m_max_load_factor, other.m_max_load_factor);
+      std::swap(m_hash, other.m_hash);
+      std::swap(m_eq, other.m_eq);
+      std::swap(m_alloc, other.m_alloc);
+    }
+
+    node_type extract(const Key &k) {
+      auto const [idx, found] = locate(k);
+      if (!found) return {};
+      node_type nh(std::pair<Key, Val>(m_slots[idx].first, std::move(m_slots[idx].second)));
+      erase_at(idx);
+      return nh;
+    }
+    node_type extract(const_iterator pos) {
+      node_type nh(std::pair<Key, Val>(m_slots[pos.m_idx].first, std::move(m_slots[pos.m_idx].second)));
+      erase_at(pos.m_idx);
+      return nh;
+    }
+
+    void merge(FlatHashMap &source) {
+      for (size_type i = 0; i < source.m_capacity; ++i) {
+        if (!is_full(source.m_ctrl[i])) continue;
+        if (locate(source.m_slots[i].first).second) continue;
+        (void) emplace(source.m_slots[i].first, std::move(source.m_slots[i].second));
+        source.erase_at(i);
+      }
+    }
+    void merge(FlatHashMap &&source) { merge(source); }
+    void merge(std::unordered_multimap<Key, Val, Hash, Pred, Allocator> &source) {
+      for (auto it = source.begin(); it != source.end();) {
+        if (locate(it->first).second) {
+          ++it;
+          continue;
+        }
+        auto const cur = it++;
+        auto nh        = source.extract(cur);
+        (void) try_emplace(std::move(nh.key()), std::move(nh.mapped()));
+      }
+    }
+    void merge(std::unordered_multimap<Key, Val, Hash, Pred, Allocator> &&source) { merge(source); }
+
+    // ------------------------------ Accessors --------------------------------- //
+    Val &at(const Key &key) {
+      auto const [idx, found] = locate(key);
+      if (!found) {
+        throw std::out_of_range("concurrency::FlatHashMap::at");
+      }
+      return m_slots[idx].second;
+    }
+    const Val &at(const Key &key) const {
+      auto const [idx, found] = locate(key);
+      if (!found) {
+        throw std::out_of_range("concurrency::FlatHashMap::at");
+      }
+      return m_slots[idx].second;
+    }
+
+    Val &operator[](const Key &key) { return try_emplace(key).first->second; }
+    Val &operator[](Key &&key) { return try_emplace(std::move(key)).first->second; }
+
+    size_type count(const Key &key) const { return locate(key).second ? 1 : 0; }
+
+    iterator find(const Key &key) {
+      auto const [idx, found] = locate(key);
+      return found ? iterator(this, idx) : end();
+    }
+    const_iterator find(const Key &key) const {
+      auto const [idx, found] = locate(key);
+      return found ? const_iterator(this, idx) : end();
+    }
+
+    // ---------------------------- Bucket interface ---------------------------- //
+    // Open addressing has one slot per "bucket"; these exist for
+    // interface parity with std::unordered_map.
+    size_type bucket_count() const noexcept { return m_capacity; }
+    size_type max_bucket_count() const noexcept { return max_size(); }
+    size_type bucket_size(size_type const n) const { return n < m_capacity && is_full(m_ctrl[n]) ? 1 : 0; }
+    size_type bucket(const Key &key) const {
+      auto const [idx, found] = locate(key);
+      return found ? idx : (m_capacity ? (m_hash(key) & (m_capacity - 1)) : 0);
+    }
+
+    // Bytes held by the table: the object itself plus the slot and
+    // control arrays. Exact, since open addressing keeps all storage in
+    // those two allocations — contrast with the node-layout estimate in
+    // UnorderedMap::memory_usage. This function does not exist for
+    // std::unordered_map.
+    size_type memory_usage() const noexcept { return sizeof(*this) + m_capacity * (sizeof(value_type) + sizeof(uint8_t)); }
+
+    // ------------------------------ Hash Policy ------------------------------- //
+    float load_factor() const noexcept { return m_capacity == 0 ? 0.0f : static_cast<float>(m_size) / static_cast<float>(m_capacity); }
+    float max_load_factor() const noexcept { return m_max_load_factor; }
+    void max_load_factor(float const ml) noexcept { m_max_load_factor = ml; }
+
+    void rehash(size_type count) {
+      size_type ncap = k_min_capacity;
+      while (ncap < count) ncap *= 2;
+      while (static_cast<float>(m_size) > static_cast<float>(ncap) * effective_load_factor()) ncap *= 2;
+      if (ncap == m_capacity && m_tombstones == 0) return;
+      resize_to(ncap);
+    }
+    void reserve(size_type const count) { rehash(static_cast<size_type>(static_cast<float>(count) / effective_load_factor()) + 1); }
+
+    // ------------------------------- Observers -------------------------------- //
+    hasher hash_function() const { return m_hash; }
+    key_equal key_eq() const { return m_eq; }
+
+  private:
+    static bool is_full(uint8_t const ctrl) noexcept { return ctrl < k_ctrl_tombstone; }
+    static uint8_t fragment(size_t const h) noexcept { return static_cast<uint8_t>((h >> 57) & 0x7F); }
+
+    float effective_load_factor() const noexcept { return m_max_load_factor < k_max_usable_load_factor ? m_max_load_factor : k_max_usable_load_factor; }
+
+    // Probes for the key. Returns {slot index, true} when present; the
+    // index is meaningless when not found.
+    std::pair<size_type, bool> locate(const Key &key) const {
+      if (m_capacity == 0) return {0, false};
+      size_t const h    = m_hash(key);
+      uint8_t const f   = fragment(h);
+      size_type const mask = m_capacity - 1;
+      for (size_type idx = h & mask;; idx = (idx + 1) & mask) {
+        if (m_ctrl[idx] == k_ctrl_empty) return {idx, false};
+        if (m_ctrl[idx] == f && m_eq(m_slots[idx].first, key)) return {idx, true};
+      }
+    }
+
+    // Probes for the key, growing first if an insert may not fit.
+    // Returns {slot index, found}; when not found, the index is the slot
+    // a new element should occupy (reusing the earliest tombstone on the
+    // probe path).
+    std::pair<size_type, bool> locate_for_insert(const Key &key) {
+      if (m_capacity == 0 || static_cast<float>(m_size + m_tombstones + 1) > static_cast<float>(m_capacity) * effective_load_factor()) {
+        resize_to(m_capacity == 0 ? k_min_capacity : m_capacity * 2);
+      }
+      size_t const h    = m_hash(key);
+      uint8_t const f   = fragment(h);
+      size_type const mask = m_capacity - 1;
+      size_type first_tombstone = m_capacity;
+      for (size_type idx = h & mask;; idx = (idx + 1) & mask) {
+        if (m_ctrl[idx] == k_ctrl_empty) {
+          return {first_tombstone < m_capacity ? first_tombstone : idx, false};
+        }
+        if (m_ctrl[idx] == k_ctrl_tombstone) {
+          if (first_tombstone == m_capacity) first_tombstone = idx;
+          continue;
+        }
+        if (m_ctrl[idx] == f && m_eq(m_slots[idx].first, key)) return {idx, true};
+      }
+    }
+
+    // Constructs the provided value in the (empty or tombstoned) slot.
+    // Hashes the key from the constructed slot rather than any caller-side
+    // copy, which may have been moved from while building the value.
+    iterator construct_at(size_type const idx, value_type &&value) {
+      if (m_ctrl[idx] == k_ctrl_tombstone) --m_tombstones;
+      std::allocator_traits<Allocator>::construct(m_alloc, m_slots + idx, std::move(value));
+      m_ctrl[idx] = fragment(m_hash(m_slots[idx].first));
+      ++m_size;
+      return iterator(this, idx);
+    }
+
+    void erase_at(size_type const idx) {
+      std::allocator_traits<Allocator>::destroy(m_alloc, m_slots + idx);
+      m_ctrl[idx] = k_ctrl_tombstone;
+      --m_size;
+      ++m_tombstones;
+    }
+
+    void destroy_slots() noexcept {
+      for (size_type i = 0; i < m_capacity; ++i) {
+        if (is_full(m_ctrl[i])) {
+          std::allocator_traits<Allocator>::destroy(m_alloc, m_slots + i);
+        }
+      }
+    }
+
+    void deallocate_arrays() noexcept {
+      if (m_capacity == 0) return;
+      std::allocator_traits<Allocator>::deallocate(m_alloc, m_slots, m_capacity);
+      ctrl_allocator ca(m_alloc);
+      std::allocator_traits<ctrl_allocator>::deallocate(ca, m_ctrl, m_capacity);
+    }
+
+    void resize_to(size_type const ncap) {
+      value_type *old_slots    = m_slots;
+      uint8_t *old_ctrl        = m_ctrl;
+      size_type const old_cap  = m_capacity;
+
+      m_slots = std::allocator_traits<Allocator>::allocate(m_alloc, ncap);
+      ctrl_allocator ca(m_alloc);
+      m_ctrl = std::allocator_traits<ctrl_allocator>::allocate(ca, ncap);
+      for (size_type i = 0; i < ncap; ++i) {
+        m_ctrl[i] = k_ctrl_empty;
+      }
+      m_capacity   = ncap;
+      m_size       = 0;
+      m_tombstones = 0;
+
+      for (size_type i = 0; i < old_cap; ++i) {
+        if (!is_full(old_ctrl[i])) continue;
+        auto const [idx, found] = locate_for_insert(old_slots[i].first);
+        (void) found; // Keys were unique in the old table.
+        (void) construct_at(idx, std::move(old_slots[i]));
+        std::allocator_traits<Allocator>::destroy(m_alloc, old_slots + i);
+      }
+      if (old_cap != 0) {
+        std::allocator_traits<Allocator>::deallocate(m_alloc, old_slots, old_cap);
+        std::allocator_traits<ctrl_allocator>::deallocate(ca, old_ctrl, old_cap);
+      }
+    }
+
+    using ctrl_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<uint8_t>;
+
+    value_type *m_slots{nullptr};
+    uint8_t *m_ctrl{nullptr};
+    size_type m_capacity{0};
+    size_type m_size{0};
+    size_type m_tombstones{0};
+    float m_max_load_factor{k_max_usable_load_factor};
+    hasher m_hash{};
+    key_equal m_eq{};
+    Allocator m_alloc{};
+  };
+
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+  bool operator==(const ::concurrency::FlatHashMap<Key, T, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::FlatHashMap<Key, T, Hash, KeyEqual, Alloc> &rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    for (auto const &el: lhs) {
+      auto const it = rhs.find(el.first);
+      if (it == rhs.end() || !(it->second == el.second)) return false;
+    }
+    return true;
+  }
+
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+  bool operator!=(const ::concurrency::FlatHashMap<Key, T, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::FlatHashMap<Key, T, Hash, KeyEqual, Alloc> &rhs) {
+    return !(lhs == rhs);
+  }
+
+  // Specializes the std::swap algorithm for ::concurrency::FlatHashMap. Swaps the contents of lhs and rhs. Calls lhs.swap(rhs).
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+  void swap(::concurrency::FlatHashMap<Key, T, Hash, KeyEqual, Alloc> &lhs, ::concurrency::FlatHashMap<Key, T, Hash, KeyEqual, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+  // Backend selector wiring FlatHashMap under the locked wrappers, e.g.
+  // UnorderedMap<K, V, Hash, Pred, Alloc, StatsPolicy, FlatBackend>. See
+  // the NodeBackend default in UnorderedMap.hpp.
+  struct FlatBackend {
+    template <class K, class V, class H, class P, class A>
+    using map_type = FlatHashMap<K, V, H, P, A>;
+  };
+
+} // namespace concurrency
+#endif // CONCURRENT_MAP_FLAT_HASH_MAP
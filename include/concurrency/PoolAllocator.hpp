@@ -0,0 +1,161 @@
+#ifndef CONCURRENT_MAP_POOL_ALLOCATOR
+#define CONCURRENT_MAP_POOL_ALLOCATOR
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace concurrency {
+
+  namespace internal {
+
+    // Size-class segregated arena backing pool_allocator. Memory is carved
+    // from large chunks obtained with ::operator new; freed blocks go onto
+    // a per-size free list (a single pointer push, no call into the global
+    // allocator), and every chunk is returned at once when the arena is
+    // destroyed. Allocations larger than the pooled maximum — bucket
+    // arrays, for instance — pass straight through to ::operator new.
+    //
+    // The arena is NOT internally synchronized. It is intended to be owned
+    // by a single UnorderedMap (one per shard in the sharded maps), whose
+    // write lock already serializes every allocating operation.
+    class pool_arena {
+    public:
+      static constexpr size_t k_alignment        = alignof(std::max_align_t);
+      static constexpr size_t k_max_pooled_bytes = 1024;
+      static constexpr size_t k_chunk_bytes      = 64 * 1024;
+
+      pool_arena()                   = default;
+      pool_arena(const pool_arena &) = delete;
+      pool_arena &operator=(const pool_arena &) = delete;
+      ~pool_arena() { release(); }
+
+      void *allocate(size_t bytes) {
+        if (bytes == 0) bytes = 1;
+        if (bytes > k_max_pooled_bytes) {
+          return ::operator new(bytes);
+        }
+        size_t const cls = size_class(bytes);
+        if (m_free_lists[cls] != nullptr) {
+          void *const p    = m_free_lists[cls];
+          m_free_lists[cls] = *static_cast<void **>(p);
+          return p;
+        }
+        size_t const block = (cls + 1) * k_alignment;
+        if (m_remaining < block) {
+          grow(block);
+        }
+        void *const p = m_cursor;
+        m_cursor += block;
+        m_remaining -= block;
+        return p;
+      }
+
+      void deallocate(void *const p, size_t bytes) noexcept {
+        if (bytes == 0) bytes = 1;
+        if (bytes > k_max_pooled_bytes) {
+          ::operator delete(p);
+          return;
+        }
+        size_t const cls          = size_class(bytes);
+        *static_cast<void **>(p) = m_free_lists[cls];
+        m_free_lists[cls]        = p;
+      }
+
+      // Returns every chunk to the global allocator in one pass. Only safe
+      // once no container is still holding memory from this arena, which
+      // is why pool_allocator exposes no way to call it directly; it runs
+      // when the last allocator sharing the arena goes away.
+      void release() noexcept {
+        for (auto *const chunk: m_chunks) {
+          ::operator delete(chunk);
+        }
+        m_chunks.clear();
+        m_free_lists.fill(nullptr);
+        m_cursor    = nullptr;
+        m_remaining = 0;
+      }
+
+    private:
+      // Blocks are multiples of k_alignment, so every class can hold the
+      // free-list link pointer and every carved address stays max-aligned.
+      static size_t size_class(size_t const bytes) noexcept { return (bytes - 1) / k_alignment; }
+
+      void grow(size_t const need) {
+        size_t const sz = need > k_chunk_bytes ? need : k_chunk_bytes;
+        void *const p   = ::operator new(sz);
+        m_chunks.push_back(p);
+        m_cursor    = static_cast<unsigned char *>(p);
+        m_remaining = sz;
+      }
+
+      std::array<void *, k_max_pooled_bytes / k_alignment> m_free_lists{};
+      std::vector<void *> m_chunks{};
+      unsigned char *m_cursor{nullptr};
+      size_t m_remaining{0};
+    };
+
+  } // namespace internal
+
+  // Arena-backed allocator for the maps' Allocator parameter. Each
+  // default-constructed pool_allocator owns a fresh arena, so the sharded
+  // maps — whose shards default-construct their allocators — get one
+  // independent arena per shard with no cross-shard contention. Node
+  // frees are O(1) pointer pushes into the owning arena's free list, and
+  // the arena's chunks are released in bulk when its last allocator
+  // (including rebound copies held by the container) is destroyed.
+  //
+  // Copies and rebound copies share the arena; two allocators compare
+  // equal exactly when they share one. Because the arena is not
+  // internally synchronized, arena sharing must never outlive the single
+  // lock that serializes it: container copies (including the snapshot a
+  // map's data() hands out) get a fresh arena of their own via
+  // select_on_container_copy_construction, and copy assignment does not
+  // propagate the source's arena — the target keeps its own. Moves and
+  // swaps transfer the whole container, so those propagate the arena
+  // along with the memory it backs.
+  template <class T>
+  class pool_allocator {
+  public:
+    using value_type                             = T;
+    using size_type                              = size_t;
+    using difference_type                        = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    pool_allocator() : m_arena(std::make_shared<internal::pool_arena>()) {}
+    explicit pool_allocator(std::shared_ptr<internal::pool_arena> arena) noexcept : m_arena(std::move(arena)) {}
+    template <class U>
+    pool_allocator(const pool_allocator<U> &other) noexcept : m_arena(other.arena()) {}
+
+    // A copied container must not allocate from — or later free into —
+    // the source's unsynchronized arena, whose owner keeps mutating it
+    // under its own lock. Hand the copy a fresh arena instead.
+    pool_allocator select_on_container_copy_construction() const { return pool_allocator(); }
+
+    T *allocate(size_type const n) { return static_cast<T *>(m_arena->allocate(n * sizeof(T))); }
+    void deallocate(T *const p, size_type const n) noexcept { m_arena->deallocate(p, n * sizeof(T)); }
+
+    std::shared_ptr<internal::pool_arena> const &arena() const noexcept { return m_arena; }
+
+  private:
+    std::shared_ptr<internal::pool_arena> m_arena;
+  };
+
+  template <class T, class U>
+  bool operator==(const pool_allocator<T> &lhs, const pool_allocator<U> &rhs) noexcept {
+    return lhs.arena() == rhs.arena();
+  }
+
+  template <class T, class U>
+  bool operator!=(const pool_allocator<T> &lhs, const pool_allocator<U> &rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+} // namespace concurrency
+#endif // CONCURRENT_MAP_POOL_ALLOCATOR
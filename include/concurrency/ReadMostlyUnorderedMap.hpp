@@ -0,0 +1,192 @@
+#ifndef READ_MOSTLY_UNORDERED_CONCURRENT_MAP_H
+#define READ_MOSTLY_UNORDERED_CONCURRENT_MAP_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace concurrency {
+
+  // This class provides a thread-safe unordered map optimized for
+  // read-mostly workloads. Readers never acquire a mutex: every lookup
+  // runs against an immutable snapshot published through an atomically
+  // swapped shared_ptr, so reads are wait-free and scale linearly with
+  // cores. Writers serialize on a mutex, copy the current snapshot,
+  // apply their mutation, and publish the result — every write costs
+  // O(size). Use UnorderedMap instead when writes are more than a small
+  // fraction of operations.
+  //
+  // As with UnorderedMap, no iterator access is provided, and functions
+  // that behave differently than their std::unordered_map counterpart of
+  // the same name are documented with comments. The modifier surface is
+  // intentionally smaller than UnorderedMap's; node extraction and merge
+  // make no sense when every write already rebuilds the snapshot.
+  template <class Key, class Val, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Val>>>
+  class ReadMostlyUnorderedMap {
+  public:
+    // ------------------------------ Member types ------------------------------ //
+    using self_type         = ReadMostlyUnorderedMap<Key, Val, Hash, Pred, Allocator>;
+    using internal_map_type = std::unordered_map<Key, Val, Hash, Pred, Allocator>;
+    using key_type          = typename internal_map_type::key_type;
+    using mapped_type       = typename internal_map_type::mapped_type;
+    using value_type        = typename internal_map_type::value_type;
+    using size_type         = typename internal_map_type::size_type;
+    using difference_type   = typename internal_map_type::difference_type;
+    using hasher            = typename internal_map_type::hasher;
+    using key_equal         = typename internal_map_type::key_equal;
+    using allocator_type    = typename internal_map_type::allocator_type;
+
+    // ------------------------------ Constructors ------------------------------ //
+    ReadMostlyUnorderedMap() = default;
+    ReadMostlyUnorderedMap(const ReadMostlyUnorderedMap &other) { publish(std::make_shared<internal_map_type>(other.data())); }
+    ReadMostlyUnorderedMap(ReadMostlyUnorderedMap &&other) { publish(std::make_shared<internal_map_type>(other.data())); }
+    ReadMostlyUnorderedMap(std::initializer_list<value_type> ilist) { insert(ilist); }
+
+    ReadMostlyUnorderedMap &operator=(const ReadMostlyUnorderedMap &other) {
+      publish(std::make_shared<internal_map_type>(other.data()));
+      return *this;
+    }
+    ReadMostlyUnorderedMap &operator=(ReadMostlyUnorderedMap &&other) noexcept {
+      publish(std::make_shared<internal_map_type>(other.data()));
+      return *this;
+    }
+    ReadMostlyUnorderedMap &operator=(std::initializer_list<value_type> ilist) {
+      this->insert(ilist);
+      return *this;
+    }
+
+    ~ReadMostlyUnorderedMap() = default;
+
+    allocator_type get_allocator() const { return snapshot()->get_allocator(); }
+
+    // -------------------------------- Capacity -------------------------------- //
+    bool empty() const noexcept { return snapshot()->empty(); }
+
+    size_type size() const noexcept { return snapshot()->size(); }
+
+    size_type max_size() const noexcept { return snapshot()->max_size(); }
+
+    // ------------------------------- Modifiers -------------------------------- //
+    void clear() noexcept {
+      std::lock_guard<std::mutex> lock(m_write_mutex);
+      publish(std::make_shared<internal_map_type>());
+    }
+
+    bool insert(const value_type &value) {
+      std::lock_guard<std::mutex> lock(m_write_mutex);
+      auto next = std::make_shared<internal_map_type>(*snapshot());
+      bool ret  = next->insert(value).second;
+      publish(std::move(next));
+      return ret;
+    }
+    bool insert(value_type &&value) {
+      std::lock_guard<std::mutex> lock(m_write_mutex);
+      auto next = std::make_shared<internal_map_type>(*snapshot());
+      bool ret  = next->insert(std::move(value)).second;
+      publish(std::move(next));
+      return ret;
+    }
+    void insert(std::initializer_list<value_type> ilist) {
+      std::lock_guard<std::mutex> lock(m_write_mutex);
+      auto next = std::make_shared<internal_map_type>(*snapshot());
+      (void) next->insert(ilist);
+      publish(std::move(next));
+    }
+
+    template <class M>
+    bool insert_or_assign(const Key &k, M &&obj) {
+      std::lock_guard<std::mutex> lock(m_write_mutex);
+      auto next = std::make_shared<internal_map_type>(*snapshot());
+      bool ret  = next->insert_or_assign(k, std::forward<M>(obj)).second;
+      publish(std::move(next));
+      return ret;
+    }
+    template <class M>
+    bool insert_or_assign(Key &&k, M &&obj) {
+      std::lock_guard<std::mutex> lock(m_write_mutex);
+      auto next = std::make_shared<internal_map_type>(*snapshot());
+      bool ret  = next->insert_or_assign(std::move(k), std::forward<M>(obj)).second;
+      publish(std::move(next));
+      return ret;
+    }
+
+    size_type erase(const Key &key) {
+      std::lock_guard<std::mutex> lock(m_write_mutex);
+      auto next     = std::make_shared<internal_map_type>(*snapshot());
+      size_type ret = next->erase(key);
+      publish(std::move(next));
+      return ret;
+    }
+
+    // ------------------------------ Accessors --------------------------------- //
+    // Returns a copy of the element mapped to
+    // the provided key. Does bounds checking.
+    Val at(const Key &key) const { return snapshot()->at(key); }
+
+    size_type count(const Key &key) const { return snapshot()->count(key); }
+
+    // Returns a bool indicating whether or not the
+    // provided key is present in the map.
+    bool find(const Key &key) const {
+      auto snap = snapshot();
+      return snap->find(key) != snap->end();
+    }
+
+    // Invokes the provided callable on a const reference to the element
+    // mapped to the provided key. The callable runs against the snapshot
+    // current when cvisit was called; a concurrent writer may publish a
+    // newer snapshot while it runs. Returns false without invoking the
+    // callable if no element is present.
+    template <class F>
+    bool cvisit(const Key &key, F &&f) const {
+      auto snap = snapshot();
+      auto it   = snap->find(key);
+      if (it == snap->end()) return false;
+      std::forward<F>(f)(it->second);
+      return true;
+    }
+
+    // Invokes the provided callable on a const reference to each element
+    // of the snapshot current when for_each was called.
+    template <class F>
+    void for_each(F &&f) const {
+      auto snap = snapshot();
+      for (auto const &el: *snap) {
+        f(el);
+      }
+    }
+
+    // Returns a non-thread-safe copy of the underlying map.
+    internal_map_type data() const { return *snapshot(); }
+
+    // ------------------------------- Observers -------------------------------- //
+    hasher hash_function() const { return snapshot()->hash_function(); }
+
+    key_equal key_eq() const { return snapshot()->key_eq(); }
+
+  private:
+    // Returns the current immutable snapshot. Safe to call without any lock.
+    std::shared_ptr<const internal_map_type> snapshot() const { return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire); }
+
+    // Publishes a new snapshot. Callers mutating based on the previous
+    // snapshot must hold m_write_mutex across the read-copy-update.
+    void publish(std::shared_ptr<internal_map_type> next) { std::atomic_store_explicit(&m_snapshot, std::shared_ptr<const internal_map_type>(std::move(next)), std::memory_order_release); }
+
+    mutable std::mutex m_write_mutex{};
+    std::shared_ptr<const internal_map_type> m_snapshot{std::make_shared<internal_map_type>()};
+  };
+
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+  bool operator==(const ::concurrency::ReadMostlyUnorderedMap<Key, T, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::ReadMostlyUnorderedMap<Key, T, Hash, KeyEqual, Alloc> &rhs) {
+    return lhs.data() == rhs.data();
+  }
+
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+  bool operator!=(const ::concurrency::ReadMostlyUnorderedMap<Key, T, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::ReadMostlyUnorderedMap<Key, T, Hash, KeyEqual, Alloc> &rhs) {
+    return !(lhs == rhs);
+  }
+
+} // namespace concurrency
+
+#endif // READ_MOSTLY_UNORDERED_CONCURRENT_MAP_H
@@ -2,10 +2,91 @@
 #define SHARDED_UNORDERED_CONCURRENT_MAP
 
 #include <concurrency/UnorderedMap.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace concurrency {
   constexpr uint32_t DefaultUnorderedMapShardCount = 32;
 
+  // Alignment boundary used to pad shards apart. Deliberately a fixed 64
+  // (the line size on effectively every mainstream target) rather than
+  // std::hardware_destructive_interference_size: GCC warns against baking
+  // that tuning-dependent constant into headers (-Winterference-size)
+  // because it silently changes struct layout across builds.
+  constexpr size_t UnorderedMapShardAlignment = 64;
+
+  namespace internal {
+    // Pads a shard out to its own cache line(s). Without this, adjacent
+    // shards' mutexes sit back-to-back in the shard array and share cache
+    // lines, so independent writers on neighboring shards invalidate each
+    // other's lines on every lock acquisition (false sharing). Inherits
+    // rather than wraps so call sites can use shards directly. Costs up to
+    // UnorderedMapShardAlignment - 1 bytes of padding per shard.
+    template <class shard_type>
+    struct alignas(UnorderedMapShardAlignment) AlignedShard : shard_type {};
+
+    // Byte-level encoder used by the snapshot format (see
+    // ShardedUnorderedMap::serialize). Trivially copyable types are
+    // written as raw native-endian bytes; std::string is length-prefixed.
+    // Specialize for other key or value types. Snapshots are not portable
+    // across architectures with different endianness or type sizes.
+    template <class T, class Enable = void>
+    struct SnapshotCodec;
+
+    template <class T>
+    struct SnapshotCodec<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+      static void write(std::ostream &os, T const &v) { os.write(reinterpret_cast<const char *>(&v), sizeof(T)); }
+      static void read(std::istream &is, T &v) { is.read(reinterpret_cast<char *>(&v), sizeof(T)); }
+    };
+
+    template <>
+    struct SnapshotCodec<std::string> {
+      static void write(std::ostream &os, std::string const &v) {
+        uint64_t const size = v.size();
+        os.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        os.write(v.data(), static_cast<std::streamsize>(size));
+      }
+      static void read(std::istream &is, std::string &v) {
+        uint64_t size = 0;
+        is.read(reinterpret_cast<char *>(&size), sizeof(size));
+        v.resize(size);
+        is.read(v.data(), static_cast<std::streamsize>(size));
+      }
+    };
+  } // namespace internal
+
+  // Cross-shard aggregation of per-shard instrumentation counters, as
+  // returned by stats_summary() on the sharded maps. Per-shard ops are
+  // read plus write lock acquisitions; a large max/mean ratio or stddev
+  // signals a hot shard (key skew), pointing at the Hash or ShardCount
+  // choice. All zeros (aside from the element fields) unless stats
+  // tracking is enabled via the StatsPolicy template parameter.
+  struct ShardedUnorderedMapStatsSummary {
+    uint64_t total_read_ops{0};
+    uint64_t total_write_ops{0};
+    std::chrono::nanoseconds total_read_lock_wait{0};
+    std::chrono::nanoseconds total_write_lock_wait{0};
+    uint64_t min_shard_ops{0};
+    uint64_t max_shard_ops{0};
+    double mean_shard_ops{0};
+    double stddev_shard_ops{0};
+    size_t min_shard_elements{0};
+    size_t max_shard_elements{0};
+    double mean_shard_elements{0};
+    double stddev_shard_elements{0};
+  };
+
   // This class provides a sharded, thread-safe, unordered map with most of the same
   // functionality as std::unordered_map. However, iterator access has been removed in order
   // to preserve thread-safety. No direct access to begin() or end() iterators is provided.
@@ -17,13 +98,13 @@ namespace concurrency {
   // do not exist for std::unordered_map.
   //
   // https://en.cppreference.com/w/cpp/container/unordered_map
-  // TODO: Support emplace() and try_emplace().
-  template <class Key, class Val, uint32_t ShardCount = DefaultUnorderedMapShardCount, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Val>>>
+  template <class Key, class Val, uint32_t ShardCount = DefaultUnorderedMapShardCount, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Val>>,
+            class StatsPolicy = NullUnorderedMapStatsPolicy, class Backend = NodeBackend, class FilterPolicy = NullUnorderedMapFilterPolicy>
   class ShardedUnorderedMap {
   public:
     // ------------------------------ Member types ------------------------------ //
-    using self_type            = ShardedUnorderedMap<Key, Val, ShardCount, Hash, Pred, Allocator>;
-    using shard_type           = UnorderedMap<Key, Val, Hash, Pred, Allocator>;
+    using self_type            = ShardedUnorderedMap<Key, Val, ShardCount, Hash, Pred, Allocator, StatsPolicy, Backend, FilterPolicy>;
+    using shard_type           = UnorderedMap<Key, Val, Hash, Pred, Allocator, StatsPolicy, Backend, FilterPolicy>;
     using internal_map_type    = typename shard_type::internal_map_type;
     using key_type             = typename shard_type::key_type;
     using mapped_type          = typename shard_type::mapped_type;
@@ -102,6 +183,28 @@ namespace concurrency {
       return size;
     }
 
+    // Returns the number of elements by summing each shard's lock-free
+    // counter, without acquiring any of the ShardCount locks that size()
+    // takes. The value may briefly lag concurrent mutations; use size()
+    // when an exact, linearizable answer is required. This function does
+    // not exist for std::unordered_map.
+    size_type approx_size() const noexcept {
+      size_type size = 0;
+      for (auto &s: m_shards) {
+        size += s.approx_size();
+      }
+      return size;
+    }
+
+    // Lock-free counterpart to empty(), subject to
+    // the same caveat as approx_size().
+    bool approx_empty() const noexcept {
+      for (auto &s: m_shards) {
+        if (!s.approx_empty()) return false;
+      }
+      return true;
+    }
+
     // ------------------------------- Modifiers -------------------------------- //
 
     void clear() noexcept {
@@ -111,7 +214,7 @@ namespace concurrency {
     }
 
     bool insert(const value_type &value) { return get_mutable_shard(value.first).insert(value); }
-    bool insert(value_type &&value) { return get_mutable_shard(value.first).insert(value); }
+    bool insert(value_type &&value) { return get_mutable_shard(value.first).insert(std::move(value)); }
     void insert(std::initializer_list<value_type> ilist) {
       for (auto const &el: ilist) {
         (void) insert(el);
@@ -119,65 +222,136 @@ namespace concurrency {
     }
     bool insert(node_type &&nh) { return get_mutable_shard(nh.key()).insert(std::move(nh)); }
 
+    // Inserts all elements in the range [first, last). The input is first
+    // partitioned by shard, then each touched shard is reserved and filled
+    // under a single write lock, rather than acquiring a shard lock per
+    // element. Returns the number of elements actually inserted. This
+    // function does not exist for std::unordered_map.
+    template <class InputIt>
+    size_type insert_batch(InputIt first, InputIt last) {
+      std::array<std::vector<value_type>, ShardCount> partitioned{};
+      for (auto it = first; it != last; ++it) {
+        partitioned[get_shard_idx(it->first)].push_back(*it);
+      }
+      size_type inserted = 0;
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        if (partitioned[i].empty()) continue;
+        inserted += m_shards[i].insert_batch(partitioned[i].begin(), partitioned[i].end());
+      }
+      return inserted;
+    }
+    // Inserts all elements of the provided vector. See insert_batch(InputIt, InputIt).
+    size_type insert_batch(std::vector<value_type> const &values) { return insert_batch(values.begin(), values.end()); }
+
     template <class M>
     bool insert_or_assign(const Key &k, M &&obj) {
-      return get_mutable_shard(k).insert_or_assign(k, obj);
+      return get_mutable_shard(k).insert_or_assign(k, std::forward<M>(obj));
     }
     template <class M>
     bool insert_or_assign(Key &&k, M &&obj) {
-      return get_mutable_shard(k).insert_or_assign(k, obj);
+      return get_mutable_shard(k).insert_or_assign(std::move(k), std::forward<M>(obj));
+    }
+
+    // Move-assigns over the element mapped to the provided key, in
+    // place. Returns false without inserting if the key is absent. See
+    // UnorderedMap::assign.
+    bool assign(const Key &key, Val &&val) { return get_mutable_shard(key).assign(key, std::move(val)); }
+
+    // Constructs a value_type from the provided arguments, then moves it
+    // into the owning shard. Unlike std::unordered_map::emplace, the
+    // element must be materialized before a shard can be chosen, but it is
+    // never copied.
+    template <class... Args>
+    bool emplace(Args &&...args) {
+      value_type value(std::forward<Args>(args)...);
+      return get_mutable_shard(value.first).emplace(std::move(value));
+    }
+
+    template <class... Args>
+    bool try_emplace(const Key &k, Args &&...args) {
+      return get_mutable_shard(k).try_emplace(k, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    bool try_emplace(Key &&k, Args &&...args) {
+      return get_mutable_shard(k).try_emplace(std::move(k), std::forward<Args>(args)...);
     }
 
     size_type erase(const Key &key) { return get_mutable_shard(key).erase(key); }
 
-    void swap(ShardedUnorderedMap<Key, Val, ShardCount, Hash, Pred, Allocator> &other) noexcept {
+    // Heterogeneous counterpart to erase(); see UnorderedMap::erase.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    size_type erase(K const &key) {
+      return get_mutable_shard(key).erase(key);
+    }
+
+    // Erases every element for which the provided predicate returns
+    // true, holding one write lock per shard rather than one lock
+    // acquisition per erased key. Returns the number of elements erased.
+    // See UnorderedMap::erase_if.
+    template <class P>
+    size_type erase_if(P &&pred) {
+      size_type erased = 0;
+      for (auto &s: m_shards) {
+        erased += s.erase_if(pred);
+      }
+      return erased;
+    }
+
+    void swap(self_type &other) noexcept {
       for (uint32_t i = 0; i < ShardCount; ++i) {
         this->m_shards[i].swap(other.m_shards[i]);
       }
     }
 
+    // Exchanges contents with a plain map. The incoming elements are
+    // partitioned into their destination shards by node extraction — no
+    // element copies — then each shard swaps its map out wholesale under
+    // its own write lock, and the previous shard contents are spliced
+    // back into other.
     void swap(internal_map_type &other) noexcept {
-      internal_map_type tmp = other;
-      other.clear();
-      for (auto &s: m_shards) {
-        other.merge(s.data());
+      std::array<internal_map_type, ShardCount> incoming{};
+      for (auto it = other.begin(); it != other.end();) {
+        auto node = other.extract(it++);
+        incoming[get_shard_idx(node.key())].insert(std::move(node));
       }
-      this->clear();
-      for (auto const &el: tmp) {
-        this->insert(el);
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i].swap(incoming[i]);
+        other.merge(std::move(incoming[i]));
       }
     }
 
     node_type extract(const Key &k) { return get_mutable_shard(k).extract(k); }
 
+    // Partitions source into per-shard maps by node extraction, splices
+    // each partition into its shard under a single write lock, and
+    // returns any conflicting elements to source — one pass, no element
+    // copies, as with std merge.
     void merge(internal_map_type &source) {
-      auto tmp = source;
-      for (auto const &el: tmp) {
-        if (find(el.first)) continue;
-        (void) insert(std::move(source.extract(el.first)));
+      std::array<internal_map_type, ShardCount> partitioned{};
+      for (auto it = source.begin(); it != source.end();) {
+        auto node = source.extract(it++);
+        partitioned[get_shard_idx(node.key())].insert(std::move(node));
       }
-    }
-    void merge(internal_map_type &&source) {
-      auto tmp = source;
-      for (auto const &el: tmp) {
-        if (find(el.first)) continue;
-        (void) insert(std::move(source.extract(el.first)));
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i].merge(partitioned[i]);
+        source.merge(std::move(partitioned[i]));
       }
     }
+    void merge(internal_map_type &&source) { merge(source); }
+    // As merge(internal_map_type&); of elements with equivalent keys,
+    // only the first encountered is spliced, the rest stay in source.
     void merge(std::unordered_multimap<Key, Val, Hash, Pred, Allocator> &source) {
-      auto tmp = source;
-      for (auto const &el: tmp) {
-        if (find(el.first)) continue;
-        (void) insert(std::move(source.extract(el.first)));
+      std::array<std::unordered_multimap<Key, Val, Hash, Pred, Allocator>, ShardCount> partitioned{};
+      for (auto it = source.begin(); it != source.end();) {
+        auto node = source.extract(it++);
+        partitioned[get_shard_idx(node.key())].insert(std::move(node));
       }
-    }
-    void merge(std::unordered_multimap<Key, Val, Hash, Pred, Allocator> &&source) {
-      auto tmp = source;
-      for (auto const &el: tmp) {
-        if (find(el.first)) continue;
-        (void) insert(std::move(source.extract(el.first)));
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i].merge(partitioned[i]);
+        source.merge(std::move(partitioned[i]));
       }
     }
+    void merge(std::unordered_multimap<Key, Val, Hash, Pred, Allocator> &&source) { merge(source); }
     void merge(UnorderedMap<Key, Val, Hash, Pred, Allocator> &source) {
       for (auto const &el: source.data()) {
         if (find(el.first)) continue;
@@ -190,18 +364,17 @@ namespace concurrency {
         (void) insert(std::move(source.extract(el.first)));
       }
     }
-    void merge(ShardedUnorderedMap<Key, Val, ShardCount, Hash, Pred, Allocator> &source) {
-      for (auto const &el: source.data()) {
-        if (find(el.first)) continue;
-        (void) insert(std::move(source.extract(el.first)));
-      }
-    }
-    void merge(ShardedUnorderedMap<Key, Val, ShardCount, Hash, Pred, Allocator> &&source) {
-      for (auto const &el: source.data()) {
-        if (find(el.first)) continue;
-        (void) insert(std::move(source.extract(el.first)));
+    // Same-ShardCount maps share the key partition, so element i of
+    // source's shard i belongs in this map's shard i: merge is
+    // shard-pairwise, each pair under both shards' write locks (taken
+    // deadlock-safely; see UnorderedMap::merge), with conflicting
+    // elements left in source.
+    void merge(self_type &source) {
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i].merge(static_cast<shard_type &>(source.m_shards[i]));
       }
     }
+    void merge(self_type &&source) { merge(source); }
 
     // ------------------------------ Accessors --------------------------------- //
     // Returns a copy of the element mapped to
@@ -211,6 +384,25 @@ namespace concurrency {
     // the provided key. Does bounds checking.
     Val at(const Key &&key) const { return get_shard(key).at(key); }
 
+    // Heterogeneous counterpart to at(), enabled when both Hash and Pred
+    // declare is_transparent, so e.g. a std::string_view can probe a
+    // std::string-keyed map allocation-free — see fast_hash and
+    // UnorderedMap::at.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    Val at(K const &key) const {
+      return get_shard(key).at(key);
+    }
+
+    // Returns a copy of the element mapped to the provided key, first
+    // constructing one from the provided factory callable if no element
+    // is present. The check and insertion happen under a single
+    // acquisition of the owning shard's write lock. This function does
+    // not exist for std::unordered_map.
+    template <class F>
+    Val get_or_insert(const Key &key, F &&factory) {
+      return get_mutable_shard(key).get_or_insert(key, std::forward<F>(factory));
+    }
+
     // Returns a copy of the element mapped to
     // the provided key. If no element is present,
     // a new one is default constructed.
@@ -220,12 +412,141 @@ namespace concurrency {
     // a new one is default constructed.
     Val operator[](Key &&key) { return get_mutable_shard(key)[key]; }
 
+    // Invokes the provided callable on a const reference to the element
+    // mapped to the provided key, while holding the owning shard's read
+    // lock. Returns false without invoking the callable if no element is
+    // present. This function does not exist for std::unordered_map; it
+    // provides read access to an element without copying it.
+    template <class F>
+    bool cvisit(const Key &key, F &&f) const {
+      return get_shard(key).cvisit(key, std::forward<F>(f));
+    }
+
+    // Invokes the provided callable on a mutable reference to the element
+    // mapped to the provided key, while holding the owning shard's write
+    // lock. Returns false without invoking the callable if no element is
+    // present. This function does not exist for std::unordered_map; it
+    // provides in-place access to an element without copying it.
+    template <class F>
+    bool visit(const Key &key, F &&f) {
+      return get_mutable_shard(key).visit(key, std::forward<F>(f));
+    }
+
+    // Single-lock atomic counter increment; see UnorderedMap::fetch_add.
+    Val fetch_add(const Key &key, Val const &delta) { return get_mutable_shard(key).fetch_add(key, delta); }
+
+    // Invokes the provided callable on a const reference to each element,
+    // in place, under the owning shard's read lock. Only one shard is
+    // locked at a time, so writers to other shards are never blocked and
+    // no full-map copy is made. This function does not exist for
+    // std::unordered_map.
+    template <class F>
+    void for_each(F &&f) const {
+      for (auto &s: m_shards) {
+        s.for_each(f);
+      }
+    }
+
+    // As for_each(F &&), but dispatches shards across the requested number
+    // of threads. The callable must be safe to invoke concurrently. A
+    // thread_count of 0 is treated as 1; thread counts beyond ShardCount
+    // are clamped.
+    template <class F>
+    void for_each(F &&f, uint32_t const thread_count) const {
+      uint32_t const threads_to_use = std::min(thread_count == 0 ? 1 : thread_count, ShardCount);
+      std::vector<std::thread> threads;
+      threads.reserve(threads_to_use);
+      for (uint32_t t = 0; t < threads_to_use; ++t) {
+        threads.emplace_back([this, &f, t, threads_to_use]() {
+          for (uint32_t i = t; i < ShardCount; i += threads_to_use) {
+            m_shards[i].for_each(f);
+          }
+        });
+      }
+      for (auto &t: threads) {
+        t.join();
+      }
+    }
+
+    // Invokes the provided callable with each shard's index and a const
+    // reference to the shard itself. The shard is thread-safe in its own
+    // right; no additional locking is performed here. This function does
+    // not exist for std::unordered_map.
+    template <class F>
+    void for_each_shard(F &&f) const {
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        f(i, m_shards[i]);
+      }
+    }
+
     size_type count(const Key &key) const { return get_shard(key).count(key); }
 
+    // Heterogeneous counterpart to count(); see UnorderedMap::count.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    size_type count(K const &key) const {
+      return get_shard(key).count(key);
+    }
+
+    // Predicate-counting across all shards, one read lock per shard; see
+    // UnorderedMap::count_if.
+    template <class P>
+    size_type count_if(P &&pred) const {
+      size_type count = 0;
+      for (auto &s: m_shards) {
+        count += s.count_if(pred);
+      }
+      return count;
+    }
+
+    // Returns true if any element in any shard satisfies the provided
+    // predicate; stops at the first matching shard. See
+    // UnorderedMap::any_of.
+    template <class P>
+    bool any_of(P &&pred) const {
+      for (auto &s: m_shards) {
+        if (s.any_of(pred)) return true;
+      }
+      return false;
+    }
+
     // Returns a bool indicating whether or not the
     // provided key is present in the map.
     bool find(const Key &key) const { return get_shard(key).find(key); }
 
+    // Heterogeneous counterpart to find(); see UnorderedMap::find.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    bool find(K const &key) const {
+      return get_shard(key).find(key);
+    }
+
+    // Looks up all provided keys, grouping them by shard so each touched
+    // shard's read lock is acquired only once instead of once per key.
+    // The result is aligned with the input: result[i] holds the value
+    // mapped to keys[i], or an empty optional if the key is absent. This
+    // function does not exist for std::unordered_map.
+    std::vector<std::optional<Val>> find_many(std::vector<Key> const &keys) const {
+      std::vector<std::optional<Val>> results(keys.size());
+      std::array<std::vector<size_t>, ShardCount> partitioned{};
+      for (size_t i = 0; i < keys.size(); ++i) {
+        partitioned[get_shard_idx(keys[i])].push_back(i);
+      }
+      for (uint32_t s = 0; s < ShardCount; ++s) {
+        if (partitioned[s].empty()) continue;
+        std::vector<Key> shard_keys;
+        shard_keys.reserve(partitioned[s].size());
+        for (auto const i: partitioned[s]) {
+          shard_keys.push_back(keys[i]);
+        }
+        std::vector<std::optional<Val>> shard_results;
+        shard_results.reserve(shard_keys.size());
+        (void) m_shards[s].find_many(shard_keys.begin(), shard_keys.end(), std::back_inserter(shard_results));
+        for (size_t j = 0; j < partitioned[s].size(); ++j) {
+          results[partitioned[s][j]] = std::move(shard_results[j]);
+        }
+      }
+      return results;
+    }
+
     // Returns a copy of the data in each
     // shard as a single non-thread-safe unordered_map.
     internal_map_type data() const {
@@ -236,9 +557,35 @@ namespace concurrency {
       return m;
     }
 
+    // Streams the map's contents out one shard at a time, invoking the
+    // provided callable with each shard's index and a copy of that
+    // shard's contents. Each shard is copied under its own read lock,
+    // which is released before the callable runs, so writers are never
+    // blocked on more than one shard at a time and peak extra memory is
+    // one shard's copy rather than the whole map — contrast with data().
+    // Entries mutated in a shard after it has been streamed are not
+    // reflected in the snapshot. Returns the total number of elements
+    // streamed. This function does not exist for std::unordered_map.
+    template <class F>
+    size_type snapshot(F &&f) const {
+      size_type streamed = 0;
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        internal_map_type shard_data = m_shards[i].data();
+        streamed += shard_data.size();
+        f(i, std::move(shard_data));
+      }
+      return streamed;
+    }
+
     // ------------------------------ Hash Policy ------------------------------- //
     uint32_t shard_count() const noexcept { return ShardCount; }
 
+    // Returns the index of the shard that owns the given key. Useful for
+    // layering per-shard machinery on top of the map (see
+    // AsyncShardedUnorderedMap) or for diagnosing key skew alongside
+    // shard_stats(). This function does not exist for std::unordered_map.
+    uint32_t shard_idx(const Key &key) const { return get_shard_idx(key); }
+
     // Averaged load factor across all shards.
     float load_factor() const {
       float lf = 0;
@@ -258,6 +605,80 @@ namespace concurrency {
       return m_shards.at(shard_idx).load_factor();
     }
 
+    // Summed bucket count across all shards.
+    size_type bucket_count() const {
+      size_type count = 0;
+      for (auto &s: m_shards) {
+        count += s.bucket_count();
+      }
+      return count;
+    }
+
+    // Returns the bucket count of a single shard. Throws
+    // std::out_of_range if shard_idx is out of bounds. This function does
+    // not exist for std::unordered_map.
+    size_type shard_bucket_count(uint32_t const shard_idx) const { return m_shards.at(shard_idx).bucket_count(); }
+
+    // Estimated bytes of memory held by the whole map, summed across
+    // shards; see UnorderedMap::memory_usage for what is and is not
+    // counted. This function does not exist for std::unordered_map.
+    size_type memory_usage() const {
+      size_type bytes = 0;
+      for (auto &s: m_shards) {
+        bytes += s.memory_usage();
+      }
+      return bytes;
+    }
+
+    // Estimated bytes held by a single shard, for spotting skew in byte
+    // terms rather than element counts. Throws std::out_of_range if
+    // shard_idx is out of bounds. This function does not exist for
+    // std::unordered_map.
+    size_type shard_memory_usage(uint32_t const shard_idx) const { return m_shards.at(shard_idx).memory_usage(); }
+
+    // Returns the instrumentation snapshot for a single shard, including
+    // its element count. All counters are zero unless stats tracking is
+    // enabled via the StatsPolicy template parameter. Throws
+    // std::out_of_range if shard_idx is out of bounds. This function does
+    // not exist for std::unordered_map.
+    UnorderedMapStats shard_stats(uint32_t const shard_idx) const { return m_shards.at(shard_idx).stats(); }
+
+    // Aggregates every shard's counters into min/max/mean/stddev form so
+    // hot shards are visible at a glance; see
+    // ShardedUnorderedMapStatsSummary. This function does not exist for
+    // std::unordered_map.
+    ShardedUnorderedMapStatsSummary stats_summary() const {
+      ShardedUnorderedMapStatsSummary summary;
+      std::vector<double> ops;
+      std::vector<double> elements;
+      ops.reserve(ShardCount);
+      elements.reserve(ShardCount);
+      for (auto &s: m_shards) {
+        auto const st = s.stats();
+        summary.total_read_ops += st.read_lock_acquisitions;
+        summary.total_write_ops += st.write_lock_acquisitions;
+        summary.total_read_lock_wait += st.read_lock_wait;
+        summary.total_write_lock_wait += st.write_lock_wait;
+        ops.push_back(static_cast<double>(st.read_lock_acquisitions + st.write_lock_acquisitions));
+        elements.push_back(static_cast<double>(st.element_count));
+      }
+      auto const moments = [](std::vector<double> const &v, double &mean, double &stddev) {
+        mean = 0;
+        for (auto const x: v) mean += x;
+        mean       = mean / v.size();
+        double var = 0;
+        for (auto const x: v) var += (x - mean) * (x - mean);
+        stddev = std::sqrt(var / v.size());
+      };
+      summary.min_shard_ops      = static_cast<uint64_t>(*std::min_element(ops.begin(), ops.end()));
+      summary.max_shard_ops      = static_cast<uint64_t>(*std::max_element(ops.begin(), ops.end()));
+      summary.min_shard_elements = static_cast<size_t>(*std::min_element(elements.begin(), elements.end()));
+      summary.max_shard_elements = static_cast<size_t>(*std::max_element(elements.begin(), elements.end()));
+      moments(ops, summary.mean_shard_ops, summary.stddev_shard_ops);
+      moments(elements, summary.mean_shard_elements, summary.stddev_shard_elements);
+      return summary;
+    }
+
     // Returns the current maximum load factor
     // allowed for all shards.
     float max_load_factor() const { return m_shards.at(0).max_load_factor(); }
@@ -286,47 +707,201 @@ namespace concurrency {
       }
     }
 
+    // Reserves space for the expected total element count, distributed
+    // evenly across shards with a small margin for imperfect key
+    // distribution. Contrast with reserve(), which reserves the full
+    // count in every shard and so overprovisions by a factor of
+    // ShardCount when given a whole-map estimate.
+    void reserve_total(size_type expected_total_elements) {
+      for (auto &s: m_shards) {
+        s.reserve(per_shard_capacity(expected_total_elements));
+      }
+    }
+
+    // As rehash(), but treats the count as a whole-map bucket estimate
+    // distributed across shards. See reserve_total().
+    void rehash_total(size_type expected_total_buckets) {
+      for (auto &s: m_shards) {
+        s.rehash(per_shard_capacity(expected_total_buckets));
+      }
+    }
+
+    // ----------------------------- Serialization ------------------------------ //
+    // Writes a binary snapshot: a fixed header (magic, version, shard
+    // count) followed by each shard in index order as a per-shard header
+    // (element count and payload byte length) and its length-prefixed
+    // payload. The element count lets deserialize() reserve() exactly,
+    // and the byte length lets a reader seek past shards it has not
+    // loaded yet (mmap-friendly lazy restore). Each shard is written
+    // under its own read lock, so the snapshot is consistent per shard
+    // but not across shards — concurrent writers may land on either side
+    // of the cut. Encoding is internal::SnapshotCodec; native-endian, so
+    // snapshots are not portable across architectures. This function
+    // does not exist for std::unordered_map.
+    void serialize(std::ostream &os) const {
+      os.write(reinterpret_cast<const char *>(&k_snapshot_magic), sizeof(k_snapshot_magic));
+      os.write(reinterpret_cast<const char *>(&k_snapshot_version), sizeof(k_snapshot_version));
+      uint32_t const shards = ShardCount;
+      os.write(reinterpret_cast<const char *>(&shards), sizeof(shards));
+      for (auto const &s: m_shards) {
+        std::ostringstream payload;
+        uint64_t count = 0;
+        s.for_each([&payload, &count](value_type const &el) {
+          internal::SnapshotCodec<Key>::write(payload, el.first);
+          internal::SnapshotCodec<Val>::write(payload, el.second);
+          ++count;
+        });
+        std::string const bytes  = payload.str();
+        uint64_t const byte_size = bytes.size();
+        os.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        os.write(reinterpret_cast<const char *>(&byte_size), sizeof(byte_size));
+        os.write(bytes.data(), static_cast<std::streamsize>(byte_size));
+      }
+    }
+
+    // Restores a snapshot written by serialize(), replacing this map's
+    // contents. The stream is read sequentially, but shard payloads are
+    // decoded and inserted by multiple worker threads since shards are
+    // independent; each shard reserve()s its exact element count before
+    // inserting, so no rehashing occurs during restore. The shard count
+    // baked into the snapshot must match ShardCount — the partition
+    // depends on it — and Key and Val must be default-constructible.
+    // Throws std::runtime_error on a malformed or mismatched snapshot.
+    // This function does not exist for std::unordered_map.
+    void deserialize(std::istream &is) {
+      uint32_t magic = 0, version = 0, shards = 0;
+      is.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+      is.read(reinterpret_cast<char *>(&version), sizeof(version));
+      is.read(reinterpret_cast<char *>(&shards), sizeof(shards));
+      if (!is || magic != k_snapshot_magic) {
+        throw std::runtime_error("concurrency::ShardedUnorderedMap::deserialize: not a snapshot stream");
+      }
+      if (version != k_snapshot_version) {
+        throw std::runtime_error("concurrency::ShardedUnorderedMap::deserialize: unsupported snapshot version");
+      }
+      if (shards != ShardCount) {
+        throw std::runtime_error("concurrency::ShardedUnorderedMap::deserialize: snapshot shard count does not match ShardCount");
+      }
+
+      std::vector<std::pair<uint64_t, std::string>> payloads(ShardCount);
+      for (auto &[count, bytes]: payloads) {
+        uint64_t byte_size = 0;
+        is.read(reinterpret_cast<char *>(&count), sizeof(count));
+        is.read(reinterpret_cast<char *>(&byte_size), sizeof(byte_size));
+        bytes.resize(byte_size);
+        is.read(bytes.data(), static_cast<std::streamsize>(byte_size));
+        if (!is) {
+          throw std::runtime_error("concurrency::ShardedUnorderedMap::deserialize: truncated snapshot stream");
+        }
+      }
+
+      std::atomic<uint32_t> next{0};
+      std::atomic<bool> failed{false};
+      auto const decode_shards = [this, &payloads, &next, &failed]() {
+        for (uint32_t i = next.fetch_add(1); i < ShardCount; i = next.fetch_add(1)) {
+          auto const &[count, bytes] = payloads[i];
+          std::istringstream payload(bytes);
+          internal_map_type decoded;
+          decoded.reserve(count);
+          for (uint64_t n = 0; n < count; ++n) {
+            Key key{};
+            Val val{};
+            internal::SnapshotCodec<Key>::read(payload, key);
+            internal::SnapshotCodec<Val>::read(payload, val);
+            decoded.emplace(std::move(key), std::move(val));
+          }
+          if (!payload) {
+            failed.store(true);
+            return;
+          }
+          m_shards[i].swap(decoded);
+        }
+      };
+
+      uint32_t const workers = std::min<uint32_t>(std::max(1u, std::thread::hardware_concurrency()), ShardCount);
+      std::vector<std::thread> threads;
+      threads.reserve(workers);
+      for (uint32_t w = 0; w < workers; ++w) {
+        threads.emplace_back(decode_shards);
+      }
+      for (auto &t: threads) {
+        t.join();
+      }
+      if (failed.load()) {
+        throw std::runtime_error("concurrency::ShardedUnorderedMap::deserialize: corrupt shard payload");
+      }
+    }
+
     // ------------------------------- Observers -------------------------------- //
-    hasher hash_function() const { return m_shards.at(0).hash_function(); }
+    hasher hash_function() const { return m_hash; }
 
     key_equal key_eq() const { return m_shards.at(0).key_eq(); }
 
   private:
-    std::array<shard_type, ShardCount> m_shards{};
+    // "CSUM" — concurrency sharded unordered map.
+    static constexpr uint32_t k_snapshot_magic   = 0x4d555343;
+    static constexpr uint32_t k_snapshot_version = 1;
+
+    std::array<internal::AlignedShard<shard_type>, ShardCount> m_shards{};
+    hasher m_hash{};
 
     void validate_shard_count() const { static_assert(ShardCount != 0, "ShardCount template parameter must be non-zero."); }
 
-    uint32_t get_shard_idx(Key const &key) const { return hash_function()(key) % ShardCount; }
-    uint32_t get_shard_idx(Key const &&key) const { return hash_function()(key) % ShardCount; }
-    shard_type &get_mutable_shard(Key const &key) { return m_shards.at(get_shard_idx(key)); }
-    shard_type &get_mutable_shard(Key const &&key) { return m_shards.at(get_shard_idx(key)); }
-    const shard_type &get_shard(Key const &key) const { return m_shards.at(get_shard_idx(key)); }
-    const shard_type &get_shard(Key const &&key) const { return m_shards.at(get_shard_idx(key)); }
+    // Splits a whole-map capacity estimate across shards, padded by 1/8th
+    // to absorb shard skew from imperfect key distribution.
+    static size_type per_shard_capacity(size_type const total) {
+      size_type const per_shard = (total + ShardCount - 1) / ShardCount;
+      return per_shard + per_shard / 8;
+    }
+
+    // Derives a shard index from the key's hash. The hash is remixed so
+    // shard selection consumes different bits than the inner map, which
+    // derives its bucket index from the same hash value; without this,
+    // each shard would only ever populate 1/ShardCount of its buckets.
+    // Templated over the key type so transparent hashers route
+    // heterogeneous probes (e.g. std::string_view) to the owning shard
+    // without materializing a Key.
+    template <class K>
+    uint32_t get_shard_idx(K const &key) const {
+      size_t h = m_hash(key);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<uint32_t>(h % ShardCount);
+    }
+    template <class K>
+    shard_type &get_mutable_shard(K const &key) {
+      return m_shards[get_shard_idx(key)];
+    }
+    template <class K>
+    const shard_type &get_shard(K const &key) const {
+      return m_shards[get_shard_idx(key)];
+    }
   };
 
-  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc>
-  bool operator==(const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &rhs) {
+  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator==(const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &rhs) {
     return lhs.data() == rhs.data();
   }
 
-  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc>
-  bool operator!=(const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &rhs) {
+  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator!=(const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &rhs) {
     return !(lhs == rhs);
   }
 
-  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc>
-  bool operator==(const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &&rhs) {
+  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator==(const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &&rhs) {
     return lhs.data() == rhs.data();
   }
 
-  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc>
-  bool operator!=(const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &&rhs) {
+  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator!=(const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &&rhs) {
     return !(lhs == rhs);
   }
 
   // Specializes the std::swap algorithm for ::concurrency::ShardedUnorderedMap. Swaps the contents of lhs and rhs. Calls lhs.swap(rhs).
-  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc>
-  void swap(::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &lhs, ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc> &rhs) noexcept {
+  template <class Key, class T, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  void swap(::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, ::concurrency::ShardedUnorderedMap<Key, T, ShardCount, Hash, KeyEqual, Alloc, Stats, B, F> &rhs) noexcept {
     lhs.swap(rhs);
   }
 
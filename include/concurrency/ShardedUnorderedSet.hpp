@@ -0,0 +1,281 @@
+#ifndef SHARDED_UNORDERED_CONCURRENT_SET
+#define SHARDED_UNORDERED_CONCURRENT_SET
+
+#include <concurrency/ShardedUnorderedMap.hpp>
+#include <concurrency/UnorderedSet.hpp>
+#include <cstdint>
+#include <optional>
+
+namespace concurrency {
+
+  // This class provides a sharded, thread-safe, unordered set with most of
+  // the same functionality as std::unordered_set, built on the same shard
+  // machinery as ShardedUnorderedMap: UnorderedSet shards padded apart by
+  // internal::AlignedShard and selected by the same remixed-hash shard
+  // index. Iterator access has been removed in order to preserve
+  // thread-safety, as has find() — membership is queried with count() or
+  // contains().
+  //
+  // Aside from the above, functions which behave differently than their
+  // std::unordered_set counterpart of the same name are documented with
+  // comments, as are functions that do not exist for std::unordered_set.
+  //
+  // https://en.cppreference.com/w/cpp/container/unordered_set
+  template <class Key, uint32_t ShardCount = DefaultUnorderedMapShardCount, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<Key>>
+  class ShardedUnorderedSet {
+  public:
+    // ------------------------------ Member types ------------------------------ //
+    using self_type         = ShardedUnorderedSet<Key, ShardCount, Hash, Pred, Allocator>;
+    using shard_type        = UnorderedSet<Key, Hash, Pred, Allocator>;
+    using internal_set_type = typename shard_type::internal_set_type;
+    using key_type          = typename shard_type::key_type;
+    using value_type        = typename shard_type::value_type;
+    using size_type         = typename shard_type::size_type;
+    using difference_type   = typename shard_type::difference_type;
+    using hasher            = typename shard_type::hasher;
+    using key_equal         = typename shard_type::key_equal;
+    using allocator_type    = typename shard_type::allocator_type;
+
+    // ------------------------------ Constructors ------------------------------ //
+    ShardedUnorderedSet() { validate_shard_count(); }
+    ShardedUnorderedSet(const ShardedUnorderedSet &other) {
+      validate_shard_count();
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i] = other.m_shards[i];
+      }
+    }
+    ShardedUnorderedSet(ShardedUnorderedSet &&other) {
+      validate_shard_count();
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i] = other.m_shards[i];
+      }
+    }
+    ShardedUnorderedSet(std::initializer_list<value_type> ilist) {
+      validate_shard_count();
+      insert(ilist);
+    }
+
+    ShardedUnorderedSet &operator=(const ShardedUnorderedSet &other) {
+      validate_shard_count();
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i] = other.m_shards[i];
+      }
+      return *this;
+    }
+    ShardedUnorderedSet &operator=(ShardedUnorderedSet &&other) noexcept {
+      validate_shard_count();
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i] = other.m_shards[i];
+      }
+      return *this;
+    }
+    ShardedUnorderedSet &operator=(std::initializer_list<value_type> ilist) {
+      validate_shard_count();
+      this->insert(ilist);
+      return *this;
+    }
+
+    ~ShardedUnorderedSet() = default;
+
+    allocator_type get_allocator() const { return m_shards.at(0).get_allocator(); }
+
+    // -------------------------------- Capacity -------------------------------- //
+    bool empty() const noexcept {
+      for (auto &s: m_shards) {
+        if (!s.empty()) return false;
+      }
+      return true;
+    }
+
+    size_type size() const noexcept {
+      size_type size = 0;
+      for (auto &s: m_shards) {
+        size += s.size();
+      }
+      return size;
+    }
+
+    size_type max_size() const noexcept { return m_shards.at(0).max_size(); }
+
+    // Sums the shards' lock-free counters; see UnorderedMap::approx_size
+    // for the caveats. This function does not exist for
+    // std::unordered_set.
+    size_type approx_size() const noexcept {
+      size_type size = 0;
+      for (auto &s: m_shards) {
+        size += s.approx_size();
+      }
+      return size;
+    }
+
+    // Lock-free counterpart to empty(), subject to the same caveat as
+    // approx_size().
+    bool approx_empty() const noexcept {
+      for (auto &s: m_shards) {
+        if (!s.approx_empty()) return false;
+      }
+      return true;
+    }
+
+    // The number of shards. This function does not exist for
+    // std::unordered_set.
+    uint32_t shard_count() const noexcept { return ShardCount; }
+
+    // ------------------------------- Modifiers -------------------------------- //
+    void clear() noexcept {
+      for (auto &s: m_shards) {
+        s.clear();
+      }
+    }
+
+    bool insert(const value_type &value) { return get_mutable_shard(value).insert(value); }
+    bool insert(value_type &&value) {
+      auto &shard = get_mutable_shard(value);
+      return shard.insert(std::move(value));
+    }
+    void insert(std::initializer_list<value_type> ilist) {
+      for (auto const &el: ilist) {
+        (void) insert(el);
+      }
+    }
+
+    template <class... Args>
+    bool emplace(Args &&...args) {
+      // The shard cannot be chosen until the element exists.
+      value_type value(std::forward<Args>(args)...);
+      return insert(std::move(value));
+    }
+
+    size_type erase(const Key &key) { return get_mutable_shard(key).erase(key); }
+
+    // See UnorderedSet::erase_if.
+    template <class P>
+    size_type erase_if(P &&pred) {
+      size_type erased = 0;
+      for (auto &s: m_shards) {
+        erased += s.erase_if(pred);
+      }
+      return erased;
+    }
+
+    void swap(self_type &other) noexcept {
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i].swap(other.m_shards[i]);
+      }
+    }
+
+    void merge(self_type &source) {
+      for (uint32_t i = 0; i < ShardCount; ++i) {
+        m_shards[i].merge(source.m_shards[i]);
+      }
+    }
+    void merge(self_type &&source) { merge(source); }
+    void merge(internal_set_type &source) {
+      for (auto it = source.begin(); it != source.end();) {
+        if (insert(*it)) {
+          it = source.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    void merge(internal_set_type &&source) { merge(source); }
+
+    // ------------------------------ Accessors --------------------------------- //
+    size_type count(const Key &key) const { return get_shard(key).count(key); }
+
+    // Returns a bool indicating whether or not the provided key is present
+    // in the set. Exists for std::unordered_set only as of C++20.
+    bool contains(const Key &key) const { return get_shard(key).contains(key); }
+
+    // Invokes the provided callable on a const reference to each element,
+    // in place, under the owning shard's read lock; see
+    // ShardedUnorderedMap::for_each.
+    template <class F>
+    void for_each(F &&f) const {
+      for (auto &s: m_shards) {
+        s.for_each(f);
+      }
+    }
+
+    // Returns a non-thread-safe copy of all elements as a single set.
+    internal_set_type data() const {
+      internal_set_type ret;
+      for (auto &s: m_shards) {
+        ret.merge(s.data());
+      }
+      return ret;
+    }
+
+    // ------------------------------ Hash Policy ------------------------------- //
+    // Mean across shards; see ShardedUnorderedMap::load_factor.
+    float load_factor() const {
+      float sum = 0;
+      for (auto &s: m_shards) {
+        sum += s.load_factor();
+      }
+      return sum / static_cast<float>(ShardCount);
+    }
+
+    float max_load_factor() const { return m_shards.at(0).max_load_factor(); }
+
+    void max_load_factor(float ml) {
+      for (auto &s: m_shards) {
+        s.max_load_factor(ml);
+      }
+    }
+
+    void rehash(size_type count) {
+      for (auto &s: m_shards) {
+        s.rehash(count);
+      }
+    }
+
+    void reserve(size_type count) {
+      for (auto &s: m_shards) {
+        s.reserve(count);
+      }
+    }
+
+    // ------------------------------- Observers -------------------------------- //
+    hasher hash_function() const { return m_hash; }
+
+    key_equal key_eq() const { return m_shards.at(0).key_eq(); }
+
+  private:
+    std::array<internal::AlignedShard<shard_type>, ShardCount> m_shards{};
+    hasher m_hash{};
+
+    void validate_shard_count() const { static_assert(ShardCount != 0, "ShardCount template parameter must be non-zero."); }
+
+    // Same remix as ShardedUnorderedMap::get_shard_idx; see the rationale
+    // there.
+    uint32_t get_shard_idx(Key const &key) const {
+      size_t h = m_hash(key);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<uint32_t>(h % ShardCount);
+    }
+    shard_type &get_mutable_shard(Key const &key) { return m_shards[get_shard_idx(key)]; }
+    const shard_type &get_shard(Key const &key) const { return m_shards[get_shard_idx(key)]; }
+  };
+
+  template <class Key, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc>
+  bool operator==(const ::concurrency::ShardedUnorderedSet<Key, ShardCount, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::ShardedUnorderedSet<Key, ShardCount, Hash, KeyEqual, Alloc> &rhs) {
+    return lhs.data() == rhs.data();
+  }
+
+  template <class Key, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc>
+  bool operator!=(const ::concurrency::ShardedUnorderedSet<Key, ShardCount, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::ShardedUnorderedSet<Key, ShardCount, Hash, KeyEqual, Alloc> &rhs) {
+    return !(lhs == rhs);
+  }
+
+  // Specializes the std::swap algorithm for ::concurrency::ShardedUnorderedSet. Swaps the contents of lhs and rhs. Calls lhs.swap(rhs).
+  template <class Key, uint32_t ShardCount, class Hash, class KeyEqual, class Alloc>
+  void swap(::concurrency::ShardedUnorderedSet<Key, ShardCount, Hash, KeyEqual, Alloc> &lhs, ::concurrency::ShardedUnorderedSet<Key, ShardCount, Hash, KeyEqual, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+} // namespace concurrency
+#endif // SHARDED_UNORDERED_CONCURRENT_SET
@@ -1,11 +1,204 @@
 #ifndef UNORDERED_CONCURRENT_MAP_H
 #define UNORDERED_CONCURRENT_MAP_H
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
+#include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 namespace concurrency {
 
+  // Plain snapshot of one map's instrumentation counters, as returned by
+  // UnorderedMap::stats and ShardedUnorderedMap::shard_stats. All zeros
+  // (except element_count) unless stats tracking is enabled via the
+  // StatsPolicy template parameter.
+  struct UnorderedMapStats {
+    uint64_t read_lock_acquisitions{0};
+    uint64_t write_lock_acquisitions{0};
+    std::chrono::nanoseconds read_lock_wait{0};
+    std::chrono::nanoseconds write_lock_wait{0};
+    size_t element_count{0};
+  };
+
+  // Default stats policy. Every hook is an inlined no-op, so maps pay
+  // nothing for the instrumentation surface unless they opt in by
+  // passing UnorderedMapStatsPolicy instead.
+  struct NullUnorderedMapStatsPolicy {
+    static constexpr bool enabled = false;
+    void record_read_lock(std::chrono::nanoseconds) const noexcept {}
+    void record_write_lock(std::chrono::nanoseconds) const noexcept {}
+    UnorderedMapStats stats() const noexcept { return {}; }
+  };
+
+  // Opt-in stats policy. Counts lock acquisitions and accumulates time
+  // spent waiting for each lock, using relaxed atomics so the recording
+  // cost is a pair of uncontended fetch_adds per operation.
+  struct UnorderedMapStatsPolicy {
+    static constexpr bool enabled = true;
+
+    UnorderedMapStatsPolicy() = default;
+    UnorderedMapStatsPolicy(const UnorderedMapStatsPolicy &other) { *this = other; }
+    UnorderedMapStatsPolicy &operator=(const UnorderedMapStatsPolicy &other) {
+      m_read_locks.store(other.m_read_locks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_write_locks.store(other.m_write_locks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_read_wait_ns.store(other.m_read_wait_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_write_wait_ns.store(other.m_write_wait_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      return *this;
+    }
+
+    void record_read_lock(std::chrono::nanoseconds const wait) const noexcept {
+      m_read_locks.fetch_add(1, std::memory_order_relaxed);
+      m_read_wait_ns.fetch_add(wait.count(), std::memory_order_relaxed);
+    }
+    void record_write_lock(std::chrono::nanoseconds const wait) const noexcept {
+      m_write_locks.fetch_add(1, std::memory_order_relaxed);
+      m_write_wait_ns.fetch_add(wait.count(), std::memory_order_relaxed);
+    }
+    UnorderedMapStats stats() const noexcept {
+      UnorderedMapStats s;
+      s.read_lock_acquisitions  = m_read_locks.load(std::memory_order_relaxed);
+      s.write_lock_acquisitions = m_write_locks.load(std::memory_order_relaxed);
+      s.read_lock_wait          = std::chrono::nanoseconds(m_read_wait_ns.load(std::memory_order_relaxed));
+      s.write_lock_wait         = std::chrono::nanoseconds(m_write_wait_ns.load(std::memory_order_relaxed));
+      return s;
+    }
+
+  private:
+    mutable std::atomic<uint64_t> m_read_locks{0};
+    mutable std::atomic<uint64_t> m_write_locks{0};
+    mutable std::atomic<int64_t> m_read_wait_ns{0};
+    mutable std::atomic<int64_t> m_write_wait_ns{0};
+  };
+
+  namespace internal {
+    // Detects whether a backend map reports its own storage exactly (see
+    // FlatHashMap::memory_usage); UnorderedMap::memory_usage falls back
+    // to a node-layout estimate when it doesn't.
+    template <class M, class = void>
+    struct map_reports_memory : std::false_type {};
+    template <class M>
+    struct map_reports_memory<M, std::void_t<decltype(std::declval<M const &>().memory_usage())>> : std::true_type {};
+  } // namespace internal
+
+  // Default filter policy. Every hook is an inlined no-op, so maps pay
+  // nothing for the negative-cache surface unless they opt in by passing
+  // BloomUnorderedMapFilterPolicy instead.
+  struct NullUnorderedMapFilterPolicy {
+    static constexpr bool enabled = false;
+    void add(size_t) const noexcept {}
+    bool definitely_absent(size_t) const noexcept { return false; }
+    void note_erases(size_t) const noexcept {}
+    bool rebuild_due() const noexcept { return false; }
+    void begin_rebuild() const noexcept {}
+    void end_rebuild() const noexcept {}
+  };
+
+  // Opt-in probabilistic pre-filter for miss-heavy workloads: a lock-free
+  // Bloom filter the map consults before taking its read lock on lookups,
+  // so a definite miss returns without ever touching the std::shared_mutex.
+  // Two bits per key, set with relaxed fetch_or on insert; lookups that
+  // might be present (including every false positive) fall through to the
+  // normal locked probe, so answers are never wrong — only occasionally
+  // slower. Erasure cannot clear bits, so erases are counted and the
+  // filter is rebuilt from the map's contents once they pass
+  // Bits / 16; the rebuild is guarded by a generation counter (odd while
+  // in progress, seqlock-style) that lookups validate against, standing
+  // down to the locked path whenever a rebuild raced them. Bits must be a
+  // power of two; at the default 16384 the filter costs 2 KiB per map (or
+  // per shard) and keeps the false-positive rate in the low percent range
+  // up to a few thousand live keys.
+  template <size_t Bits = 16384>
+  struct BloomUnorderedMapFilterPolicy {
+    static constexpr bool enabled = true;
+    static_assert(Bits >= 64 && (Bits & (Bits - 1)) == 0, "Bits must be a power of two, at least one word's worth.");
+
+    BloomUnorderedMapFilterPolicy() = default;
+    BloomUnorderedMapFilterPolicy(const BloomUnorderedMapFilterPolicy &other) { *this = other; }
+    BloomUnorderedMapFilterPolicy &operator=(const BloomUnorderedMapFilterPolicy &other) {
+      for (size_t i = 0; i < k_words; ++i) {
+        m_words[i].store(other.m_words[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      m_erases.store(other.m_erases.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      return *this;
+    }
+
+    void add(size_t const h) const noexcept {
+      m_words[word(h)].fetch_or(bit(h), std::memory_order_relaxed);
+      size_t const h2 = remix(h);
+      m_words[word(h2)].fetch_or(bit(h2), std::memory_order_relaxed);
+    }
+
+    bool definitely_absent(size_t const h) const noexcept {
+      uint64_t const gen = m_generation.load(std::memory_order_acquire);
+      if (gen & 1) return false; // A rebuild is in progress; the bits can't be trusted.
+      size_t const h2 = remix(h);
+      bool const may_be_present =
+          (m_words[word(h)].load(std::memory_order_relaxed) & bit(h)) != 0 && (m_words[word(h2)].load(std::memory_order_relaxed) & bit(h2)) != 0;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (m_generation.load(std::memory_order_relaxed) != gen) return false; // A rebuild raced the probe.
+      return !may_be_present;
+    }
+
+    void note_erases(size_t const count) const noexcept { m_erases.fetch_add(count, std::memory_order_relaxed); }
+    bool rebuild_due() const noexcept { return m_erases.load(std::memory_order_relaxed) >= Bits / 16; }
+
+    // The rebuild hooks must be called with the owning map's write lock
+    // held, so add() cannot race the clearing.
+    void begin_rebuild() const noexcept {
+      m_generation.fetch_add(1, std::memory_order_release); // Now odd: lookups stand down.
+      // The release fence orders the increment before the clears, pairing
+      // with the acquire fence in definitely_absent: a probe that reads a
+      // cleared word is guaranteed to see the odd (or later) generation
+      // when it re-checks, and so discards the probe instead of reporting
+      // a false miss.
+      std::atomic_thread_fence(std::memory_order_release);
+      for (auto &w: m_words) {
+        w.store(0, std::memory_order_relaxed);
+      }
+    }
+    void end_rebuild() const noexcept {
+      m_erases.store(0, std::memory_order_relaxed);
+      m_generation.fetch_add(1, std::memory_order_release); // Even again: lookups may trust the bits.
+    }
+
+  private:
+    static constexpr size_t k_words = Bits / 64;
+
+    // Second probe position; the same remix the sharded maps use for
+    // shard selection, so the two probes consume independent bits.
+    static constexpr size_t remix(size_t h) noexcept {
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return h;
+    }
+    static constexpr size_t word(size_t const h) noexcept { return (h & (Bits - 1)) / 64; }
+    static constexpr uint64_t bit(size_t const h) noexcept { return uint64_t{1} << (h % 64); }
+
+    mutable std::array<std::atomic<uint64_t>, k_words> m_words{};
+    mutable std::atomic<uint64_t> m_generation{0};
+    mutable std::atomic<uint64_t> m_erases{0};
+  };
+
+  // Default backend selector: each map (or shard) wraps a
+  // std::unordered_map, whose node-based layout keeps elements and node
+  // handles stable. The alternative FlatBackend (FlatHashMap.hpp) wraps
+  // an open-addressing table with contiguous slots — roughly half the
+  // memory per entry and fewer cache misses per probe, at the cost of
+  // key copies during extract/rehash.
+  struct NodeBackend {
+    template <class K, class V, class H, class P, class A>
+    using map_type = std::unordered_map<K, V, H, P, A>;
+  };
+
   // This class provides a thread-safe unordered map with most of the same functionality as
   // std::unordered_map. However, iterator access has been removed in order to preserve
   // thread-safety. No direct access to begin() or end() iterators is provided. Iterators
@@ -17,15 +210,19 @@ namespace concurrency {
   // do not exist for std::unordered_map.
   //
   // https://en.cppreference.com/w/cpp/container/unordered_map
-  template <class Key, class Val, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Val>>>
+  template <class Key, class Val, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, Val>>,
+            class StatsPolicy = NullUnorderedMapStatsPolicy, class Backend = NodeBackend, class FilterPolicy = NullUnorderedMapFilterPolicy>
   class UnorderedMap {
   public:
     // ------------------------------ Member types ------------------------------ //
     using mutex_type           = std::shared_mutex;
     using read_lock            = std::shared_lock<mutex_type>;
     using write_lock           = std::unique_lock<mutex_type>;
-    using self_type            = UnorderedMap<Key, Val, Hash, Pred, Allocator>;
-    using internal_map_type    = std::unordered_map<Key, Val, Hash, Pred, Allocator>;
+    using self_type            = UnorderedMap<Key, Val, Hash, Pred, Allocator, StatsPolicy, Backend, FilterPolicy>;
+    using stats_policy         = StatsPolicy;
+    using backend_type         = Backend;
+    using filter_policy        = FilterPolicy;
+    using internal_map_type    = typename Backend::template map_type<Key, Val, Hash, Pred, Allocator>;
     using key_type             = typename internal_map_type::key_type;
     using mapped_type          = typename internal_map_type::mapped_type;
     using value_type           = typename internal_map_type::value_type;
@@ -49,24 +246,35 @@ namespace concurrency {
 
     // ------------------------------ Constructors ------------------------------ //
     UnorderedMap() = default;
+    // Constructs the underlying map with the given allocator instance;
+    // useful with stateful allocators such as pool_allocator.
+    explicit UnorderedMap(allocator_type const &alloc) : m_map(alloc) {}
     UnorderedMap(const UnorderedMap &other) {
       auto lock = lock_for_writing();
       m_map     = std::move(other.data());
+      update_size();
+      rebuild_filter();
     }
     UnorderedMap(UnorderedMap &&other) {
       auto lock = lock_for_writing();
       m_map     = std::move(other.data());
+      update_size();
+      rebuild_filter();
     }
     UnorderedMap(std::initializer_list<value_type> ilist) { insert(ilist); }
 
     UnorderedMap &operator=(const UnorderedMap &other) {
       auto lock   = lock_for_writing();
       this->m_map = other.data();
+      update_size();
+      rebuild_filter();
       return *this;
     }
     UnorderedMap &operator=(UnorderedMap &&other) noexcept {
       auto lock   = lock_for_writing();
       this->m_map = std::move(other.data());
+      update_size();
+      rebuild_filter();
       return *this;
     }
     UnorderedMap &operator=(std::initializer_list<value_type> ilist) {
@@ -97,112 +305,263 @@ namespace concurrency {
 
     size_type max_size() const noexcept { return m_map.max_size(); }
 
+    // Returns the number of elements without acquiring a lock. The counter
+    // is maintained with relaxed atomics, so the value may briefly lag
+    // concurrent mutations; use size() when an exact, linearizable answer
+    // is required. This function does not exist for std::unordered_map.
+    size_type approx_size() const noexcept { return m_size.load(std::memory_order_relaxed); }
+
+    // Lock-free counterpart to empty(), subject to
+    // the same caveat as approx_size().
+    bool approx_empty() const noexcept { return approx_size() == 0; }
+
     // ------------------------------- Modifiers -------------------------------- //
 
     void clear() noexcept {
       auto lock = lock_for_writing();
       m_map.clear();
+      update_size();
+      rebuild_filter();
     }
 
     bool insert(const value_type &value) {
       auto lock = lock_for_writing();
-      return m_map.insert(value).second;
+      bool ret  = m_map.insert(value).second;
+      if (ret) filter_add(value.first);
+      update_size();
+      return ret;
     }
     bool insert(value_type &&value) {
-      auto lock = lock_for_writing();
-      return m_map.insert(value).second;
+      auto lock             = lock_for_writing();
+      auto const [it, uniq] = m_map.insert(std::move(value));
+      if (uniq) filter_add(it->first);
+      update_size();
+      return uniq;
     }
     template <class P>
     bool insert(P &&value) {
-      auto lock = lock_for_writing();
-      return m_map.insert(value).second;
+      auto lock             = lock_for_writing();
+      auto const [it, uniq] = m_map.insert(std::forward<P>(value));
+      if (uniq) filter_add(it->first);
+      update_size();
+      return uniq;
     }
     void insert(std::initializer_list<value_type> ilist) {
       auto lock = lock_for_writing();
       (void) m_map.insert(ilist);
+      for (auto const &value: ilist) {
+        filter_add(value.first);
+      }
+      update_size();
+    }
+    // Inserts all elements in the range [first, last) under a single write
+    // lock. Unlike the std::unordered_map counterpart, returns the number
+    // of elements actually inserted.
+    template <class InputIt>
+    size_type insert(InputIt first, InputIt last) {
+      auto lock          = lock_for_writing();
+      size_type inserted = 0;
+      for (auto it = first; it != last; ++it) {
+        auto const [mit, uniq] = m_map.insert(*it);
+        if (uniq) {
+          filter_add(mit->first);
+          ++inserted;
+        }
+      }
+      update_size();
+      return inserted;
+    }
+    // Like insert(first, last), but additionally reserves capacity for
+    // the incoming range before inserting it, so the reservation and
+    // every insertion happen under one write-lock acquisition. The range
+    // must be multi-pass (forward iterators or better). This function
+    // does not exist for std::unordered_map.
+    template <class InputIt>
+    size_type insert_batch(InputIt first, InputIt last) {
+      auto lock = lock_for_writing();
+      m_map.reserve(m_map.size() + static_cast<size_type>(std::distance(first, last)));
+      size_type inserted = 0;
+      for (auto it = first; it != last; ++it) {
+        auto const [mit, uniq] = m_map.insert(*it);
+        if (uniq) {
+          filter_add(mit->first);
+          ++inserted;
+        }
+      }
+      update_size();
+      return inserted;
     }
     bool insert(node_type &&nh) {
-      auto lock = lock_for_writing();
-      return m_map.insert(std::move(nh)).inserted;
+      auto lock      = lock_for_writing();
+      auto const ret = m_map.insert(std::move(nh));
+      if (ret.inserted) filter_add(ret.position->first);
+      update_size();
+      return ret.inserted;
     }
 
     template <class M>
     bool insert_or_assign(const Key &k, M &&obj) {
       auto lock = lock_for_writing();
-      return m_map.insert_or_assign(k, obj).second;
+      bool ret  = m_map.insert_or_assign(k, std::forward<M>(obj)).second;
+      if (ret) filter_add(k);
+      update_size();
+      return ret;
     }
     template <class M>
     bool insert_or_assign(Key &&k, M &&obj) {
+      auto lock             = lock_for_writing();
+      auto const [it, uniq] = m_map.insert_or_assign(std::move(k), std::forward<M>(obj));
+      if (uniq) filter_add(it->first);
+      update_size();
+      return uniq;
+    }
+
+    // Move-assigns over the element mapped to the provided key, in
+    // place. Returns false without inserting if the key is absent; the
+    // overwrite path never allocates a node. This function does not
+    // exist for std::unordered_map.
+    bool assign(const Key &key, Val &&val) {
       auto lock = lock_for_writing();
-      return m_map.insert_or_assign(k, obj).second;
+      auto it   = m_map.find(key);
+      if (it == m_map.end()) return false;
+      it->second = std::move(val);
+      return true;
     }
 
     template <class... Args>
     bool emplace(Args &&...args) {
-      auto lock = lock_for_writing();
-      return m_map.emplace(args...).second;
+      auto lock             = lock_for_writing();
+      auto const [it, uniq] = m_map.emplace(std::forward<Args>(args)...);
+      if (uniq) filter_add(it->first);
+      update_size();
+      return uniq;
     }
 
     template <class... Args>
     bool try_emplace(const Key &k, Args &&...args) {
       auto lock = lock_for_writing();
-      return m_map.try_emplace(k, args...).second;
+      bool ret  = m_map.try_emplace(k, std::forward<Args>(args)...).second;
+      if (ret) filter_add(k);
+      update_size();
+      return ret;
     }
     template <class... Args>
     bool try_emplace(Key &&k, Args &&...args) {
-      auto lock = lock_for_writing();
-      return m_map.try_emplace(k, args...).second;
+      auto lock             = lock_for_writing();
+      auto const [it, uniq] = m_map.try_emplace(std::move(k), std::forward<Args>(args)...);
+      if (uniq) filter_add(it->first);
+      update_size();
+      return uniq;
     }
 
     size_type erase(const Key &key) {
-      auto lock = lock_for_writing();
-      return m_map.erase(key);
+      auto lock     = lock_for_writing();
+      size_type ret = m_map.erase(key);
+      filter_note_erases(ret);
+      update_size();
+      return ret;
+    }
+
+    // Heterogeneous counterpart to erase(); see at(K const &) for the
+    // enabling conditions. Heterogeneous erase in the standard library
+    // is C++23, so this materializes a Key internally; it still saves
+    // every call site from doing the conversion itself.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    size_type erase(K const &key) {
+      auto lock     = lock_for_writing();
+      size_type ret = m_map.erase(Key(key));
+      filter_note_erases(ret);
+      update_size();
+      return ret;
+    }
+
+    // Erases every element for which the provided predicate returns true,
+    // given a const reference to the element, under a single write lock —
+    // as opposed to one lock acquisition per erased key. Mirrors
+    // std::erase_if. Returns the number of elements erased. This function
+    // does not exist for std::unordered_map.
+    template <class P>
+    size_type erase_if(P &&pred) {
+      auto lock           = lock_for_writing();
+      size_type const old = m_map.size();
+      for (auto it = m_map.begin(); it != m_map.end();) {
+        if (pred(std::as_const(*it))) {
+          it = m_map.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      size_type const erased = old - m_map.size();
+      filter_note_erases(erased);
+      update_size();
+      return erased;
     }
 
-    void swap(UnorderedMap<Key, Val, Hash, Pred, Allocator> &other) noexcept {
-      auto lhs_lock = this->lock_for_writing();
-      auto rhs_lock = other.lock_for_writing();
+    void swap(self_type &other) noexcept {
+      if (this == &other) return;
+      // Both locks are taken via std::lock's deadlock-avoidance algorithm
+      // so concurrent a.swap(b) and b.swap(a) cannot deadlock.
+      std::scoped_lock lock(m_mutex, other.m_mutex);
       this->m_map.swap(other.m_map);
+      this->update_size();
+      other.update_size();
+      this->rebuild_filter();
+      other.rebuild_filter();
     }
 
     void swap(internal_map_type &other) noexcept {
       auto lock = lock_for_writing();
       m_map.swap(other);
+      update_size();
+      rebuild_filter();
     }
 
     node_type extract(const Key &k) {
-      auto lock = lock_for_writing();
-      return m_map.extract(k);
+      auto lock     = lock_for_writing();
+      node_type ret = m_map.extract(k);
+      if (!ret.empty()) filter_note_erases(1);
+      update_size();
+      return ret;
     }
 
     void merge(internal_map_type &source) {
       auto lock = lock_for_writing();
       m_map.merge(source);
+      update_size();
+      rebuild_filter();
     }
     void merge(internal_map_type &&source) {
       auto lock = lock_for_writing();
       m_map.merge(source);
+      update_size();
+      rebuild_filter();
     }
     void merge(std::unordered_multimap<Key, Val, Hash, Pred, Allocator> &source) {
       auto lock = lock_for_writing();
       m_map.merge(source);
+      update_size();
+      rebuild_filter();
     }
     void merge(std::unordered_multimap<Key, Val, Hash, Pred, Allocator> &&source) {
       auto lock = lock_for_writing();
       m_map.merge(source);
-    }
-    void merge(UnorderedMap<Key, Val, Hash, Pred, Allocator> &source) {
-      for (auto const &el: source.data()) {
-        if (find(el.first)) continue;
-        (void) insert(std::move(source.extract(el.first)));
-      }
-    }
-    void merge(UnorderedMap<Key, Val, Hash, Pred, Allocator> &&source) {
-      for (auto const &el: source.data()) {
-        if (find(el.first)) continue;
-        (void) insert(std::move(source.extract(el.first)));
-      }
-    }
+      update_size();
+      rebuild_filter();
+    }
+    // Splices every element whose key is not already present out of
+    // source, under both maps' write locks (taken deadlock-safely, as in
+    // swap), in a single pass of node transfers — no copies, and
+    // conflicting elements stay in source, as with std merge.
+    void merge(self_type &source) {
+      if (this == &source) return;
+      std::scoped_lock lock(m_mutex, source.m_mutex);
+      m_map.merge(source.m_map);
+      update_size();
+      source.update_size();
+      rebuild_filter();
+      source.rebuild_filter();
+    }
+    void merge(self_type &&source) { merge(source); }
 
     // ------------------------------ Accessors --------------------------------- //
     // Returns a copy of the element mapped to
@@ -218,13 +577,55 @@ namespace concurrency {
       return m_map.at(key);
     }
 
+    // Heterogeneous counterpart to at(). Participates in overload
+    // resolution only when both Hash and Pred declare is_transparent
+    // (C++20-style transparent lookup), so e.g. a std::string_view can
+    // probe a std::string-keyed map — see fast_hash. Allocation-free
+    // when the standard library provides heterogeneous unordered lookup
+    // (C++20); otherwise falls back to materializing a Key.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    Val at(K const &key) const {
+      auto lock = lock_for_reading();
+#ifdef __cpp_lib_generic_unordered_lookup
+      auto const it = m_map.find(key);
+      if (it == m_map.end()) {
+        throw std::out_of_range("concurrency::UnorderedMap::at");
+      }
+      return it->second;
+#else
+      return m_map.at(Key(key));
+#endif
+    }
+
+    // Returns a copy of the element mapped to the provided key. If no
+    // element is present, one is first constructed from the provided
+    // factory callable. Unlike operator[], the existence check and the
+    // insertion happen under a single write lock, so the map is locked
+    // exactly once and concurrent callers cannot both construct a value
+    // for the same key. This function does not exist for
+    // std::unordered_map.
+    template <class F>
+    Val get_or_insert(const Key &key, F &&factory) {
+      auto lock = lock_for_writing();
+      auto it   = m_map.find(key);
+      if (it == m_map.end()) {
+        it = m_map.emplace(key, std::forward<F>(factory)()).first;
+        filter_add(key);
+        update_size();
+      }
+      return it->second;
+    }
+
     // Returns a copy of the element mapped to
     // the provided key. If no element is present,
     // a new one is default constructed.
     Val operator[](const Key &key) {
       if (this->find(key)) return this->at(key);
       auto lock = lock_for_writing();
-      return m_map[key];
+      Val ret   = m_map[key];
+      filter_add(key);
+      update_size();
+      return ret;
     }
     // Returns a copy of the element mapped to
     // the provided key. If no element is present,
@@ -232,21 +633,163 @@ namespace concurrency {
     Val operator[](Key &&key) {
       if (this->find(key)) return this->at(key);
       auto lock = lock_for_writing();
-      return m_map[key];
+      Val ret   = m_map[key];
+      filter_add(key);
+      update_size();
+      return ret;
+    }
+
+    // Invokes the provided callable on a const reference to the element
+    // mapped to the provided key, while holding a read lock. Returns false
+    // without invoking the callable if no element is present. This function
+    // does not exist for std::unordered_map; it provides read access to an
+    // element without copying it.
+    template <class F>
+    bool cvisit(const Key &key, F &&f) const {
+      auto lock = lock_for_reading();
+      auto it   = m_map.find(key);
+      if (it == m_map.end()) return false;
+      std::forward<F>(f)(it->second);
+      return true;
+    }
+
+    // Invokes the provided callable on a mutable reference to the element
+    // mapped to the provided key, while holding a write lock. Returns false
+    // without invoking the callable if no element is present. This function
+    // does not exist for std::unordered_map; it provides in-place access to
+    // an element without copying it.
+    template <class F>
+    bool visit(const Key &key, F &&f) {
+      auto lock = lock_for_writing();
+      auto it   = m_map.find(key);
+      if (it == m_map.end()) return false;
+      std::forward<F>(f)(it->second);
+      return true;
+    }
+
+    // Atomically adds delta to the value mapped to the provided key under
+    // a single write lock, default-constructing the value first if the key
+    // is absent, and returns a copy of the resulting value. Closes the
+    // racy two-lock operator[]-then-insert_or_assign counter pattern.
+    // This function does not exist for std::unordered_map.
+    Val fetch_add(const Key &key, Val const &delta) {
+      auto lock = lock_for_writing();
+      Val &val  = m_map[key];
+      val += delta;
+      filter_add(key);
+      update_size();
+      return val;
+    }
+
+    // Invokes the provided callable on a const reference to each element
+    // while holding a read lock, avoiding the full copy that data() makes.
+    // This function does not exist for std::unordered_map.
+    template <class F>
+    void for_each(F &&f) const {
+      auto lock = lock_for_reading();
+      for (auto const &el: m_map) {
+        f(el);
+      }
     }
 
     size_type count(const Key &key) const {
+      if constexpr (FilterPolicy::enabled) {
+        if (m_filter.definitely_absent(m_hash(key))) return 0;
+      }
+      auto lock = lock_for_reading();
+      return m_map.count(key);
+    }
+
+    // Heterogeneous counterpart to count(); see at(K const &) for the
+    // enabling conditions.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    size_type count(K const &key) const {
+      if constexpr (FilterPolicy::enabled) {
+        if (m_filter.definitely_absent(m_hash(key))) return 0;
+      }
       auto lock = lock_for_reading();
+#ifdef __cpp_lib_generic_unordered_lookup
       return m_map.count(key);
+#else
+      return m_map.count(Key(key));
+#endif
     }
 
-    // Returns a bool indicating whether or not the
-    // provided key is present in the map.
+    // Returns the number of elements for which the provided predicate
+    // returns true, given a const reference to each element, under a
+    // single read lock. This function does not exist for
+    // std::unordered_map.
+    template <class P>
+    size_type count_if(P &&pred) const {
+      auto lock       = lock_for_reading();
+      size_type count = 0;
+      for (auto const &el: m_map) {
+        if (pred(el)) ++count;
+      }
+      return count;
+    }
+
+    // Returns true if the provided predicate returns true for any
+    // element, given a const reference to it, under a single read lock.
+    // Stops at the first match. This function does not exist for
+    // std::unordered_map.
+    template <class P>
+    bool any_of(P &&pred) const {
+      auto lock = lock_for_reading();
+      for (auto const &el: m_map) {
+        if (pred(el)) return true;
+      }
+      return false;
+    }
+
+    // Returns a bool indicating whether or not the provided key is
+    // present in the map. With an opt-in FilterPolicy, a definite miss
+    // returns here without ever taking the read lock; see
+    // BloomUnorderedMapFilterPolicy.
     bool find(const Key &key) const {
+      if constexpr (FilterPolicy::enabled) {
+        if (m_filter.definitely_absent(m_hash(key))) return false;
+      }
       auto lock = lock_for_reading();
       return m_map.find(key) != m_map.end();
     }
 
+    // Heterogeneous counterpart to find(); see at(K const &) for the
+    // enabling conditions.
+    template <class K, class H = hasher, class P = key_equal, class = typename H::is_transparent, class = typename P::is_transparent>
+    bool find(K const &key) const {
+      if constexpr (FilterPolicy::enabled) {
+        if (m_filter.definitely_absent(m_hash(key))) return false;
+      }
+      auto lock = lock_for_reading();
+#ifdef __cpp_lib_generic_unordered_lookup
+      return m_map.find(key) != m_map.end();
+#else
+      return m_map.find(Key(key)) != m_map.end();
+#endif
+    }
+
+    // Looks up every key in [first, last) under a single read lock,
+    // rather than paying one lock acquisition per key. For each key, in
+    // order, writes a std::optional<Val> to the output iterator — empty
+    // if the key is absent. Returns the number of keys found. This
+    // function does not exist for std::unordered_map.
+    template <class InputIt, class OutputIt>
+    size_type find_many(InputIt first, InputIt last, OutputIt out) const {
+      auto lock       = lock_for_reading();
+      size_type found = 0;
+      for (auto it = first; it != last; ++it) {
+        auto mit = m_map.find(*it);
+        if (mit == m_map.end()) {
+          *out++ = std::nullopt;
+        } else {
+          *out++ = mit->second;
+          ++found;
+        }
+      }
+      return found;
+    }
+
     // Returns a non-thread-safe copy of the underlying map.
     internal_map_type data() const {
       auto lock = lock_for_reading();
@@ -271,6 +814,26 @@ namespace concurrency {
       return m_map.bucket(key);
     }
 
+    // Estimated bytes of memory held by this map: the map object itself,
+    // the bucket array, and the elements with their per-node bookkeeping.
+    // The standard does not expose node layout, so for the node backend
+    // each bucket is costed at one pointer and each node at
+    // sizeof(value_type) plus two pointers (next pointer and cached
+    // hash); dynamic allocations owned by the elements themselves (e.g.
+    // std::string heap buffers) are not visible to the container and are
+    // not counted. Backends that track their storage exactly (see
+    // FlatHashMap::memory_usage) are asked directly. Intended for
+    // capacity planning and monitoring, not exact accounting. This
+    // function does not exist for std::unordered_map.
+    size_type memory_usage() const {
+      auto lock = lock_for_reading();
+      if constexpr (internal::map_reports_memory<internal_map_type>::value) {
+        return sizeof(*this) - sizeof(internal_map_type) + m_map.memory_usage();
+      } else {
+        return sizeof(*this) + m_map.bucket_count() * sizeof(void *) + m_map.size() * (sizeof(value_type) + 2 * sizeof(void *));
+      }
+    }
+
     // ------------------------------ Hash Policy ------------------------------- //
     float load_factor() const {
       auto lock = lock_for_reading();
@@ -302,42 +865,113 @@ namespace concurrency {
 
     key_equal key_eq() const { return m_map.key_eq(); }
 
+    // Returns a snapshot of this map's instrumentation counters. All
+    // zeros (aside from element_count) unless stats tracking is enabled
+    // via the StatsPolicy template parameter. This function does not
+    // exist for std::unordered_map.
+    UnorderedMapStats stats() const {
+      UnorderedMapStats s = m_stats.stats();
+      s.element_count     = approx_size();
+      return s;
+    }
+
   private:
     // Returns a locked read_lock that prevents concurrent write access to
     // the underlying map.
-    read_lock lock_for_reading() const { return read_lock(m_mutex); }
+    read_lock lock_for_reading() const {
+      if constexpr (StatsPolicy::enabled) {
+        auto const start = std::chrono::steady_clock::now();
+        read_lock lock(m_mutex);
+        m_stats.record_read_lock(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        return lock;
+      } else {
+        return read_lock(m_mutex);
+      }
+    }
 
     // Returns a locked write_lock that prevents concurrent access to the
     // underlying map.
-    write_lock lock_for_writing() const { return write_lock(m_mutex); }
+    write_lock lock_for_writing() const {
+      if constexpr (StatsPolicy::enabled) {
+        auto const start = std::chrono::steady_clock::now();
+        write_lock lock(m_mutex);
+        m_stats.record_write_lock(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        return lock;
+      } else {
+        return write_lock(m_mutex);
+      }
+    }
+
+    // Refreshes the lock-free element counter backing approx_size(). Must
+    // be called with the write lock held, after any operation that may
+    // have changed the size of the underlying map.
+    void update_size() noexcept { m_size.store(m_map.size(), std::memory_order_relaxed); }
+
+    // Records a key in the pre-filter. Called by every mutator that may
+    // have inserted the key; no-op unless a real FilterPolicy is in play.
+    template <class K>
+    void filter_add(K const &key) noexcept {
+      if constexpr (FilterPolicy::enabled) {
+        m_filter.add(m_hash(key));
+      }
+    }
+
+    // Accounts for erased elements, rebuilding the filter once stale bits
+    // pile up past the policy's threshold. Must be called with the write
+    // lock held.
+    void filter_note_erases(size_type const count) {
+      if constexpr (FilterPolicy::enabled) {
+        if (count == 0) return;
+        m_filter.note_erases(count);
+        if (m_filter.rebuild_due()) rebuild_filter();
+      }
+    }
+
+    // Re-derives the filter's bits from the map's current contents. Must
+    // be called with the write lock held after any bulk mutation (clear,
+    // swap, merge, assignment) that may have added or removed arbitrary
+    // keys.
+    void rebuild_filter() {
+      if constexpr (FilterPolicy::enabled) {
+        m_filter.begin_rebuild();
+        for (auto const &el: m_map) {
+          m_filter.add(m_hash(el.first));
+        }
+        m_filter.end_rebuild();
+      }
+    }
 
     mutable mutex_type m_mutex{};
     internal_map_type m_map{};
+    std::atomic<size_type> m_size{0};
+    StatsPolicy m_stats{};
+    FilterPolicy m_filter{};
+    hasher m_hash{};
   };
 
-  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
-  bool operator==(const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &rhs) {
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator==(const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &rhs) {
     return lhs.data() == rhs.data();
   }
 
-  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
-  bool operator!=(const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &rhs) {
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator!=(const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &rhs) {
     return !(lhs == rhs);
   }
 
-  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
-  bool operator==(const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &&rhs) {
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator==(const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &&rhs) {
     return lhs.data() == rhs.data();
   }
 
-  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
-  bool operator!=(const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &&rhs) {
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  bool operator!=(const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, const ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &&rhs) {
     return !(lhs == rhs);
   }
 
   // Specializes the std::swap algorithm for ::concurrency::UnorderedMap. Swaps the contents of lhs and rhs. Calls lhs.swap(rhs).
-  template <class Key, class T, class Hash, class KeyEqual, class Alloc>
-  void swap(::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &lhs, ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc> &rhs) noexcept {
+  template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Stats, class B, class F>
+  void swap(::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &lhs, ::concurrency::UnorderedMap<Key, T, Hash, KeyEqual, Alloc, Stats, B, F> &rhs) noexcept {
     lhs.swap(rhs);
   }
 
@@ -0,0 +1,291 @@
+#ifndef UNORDERED_CONCURRENT_SET
+#define UNORDERED_CONCURRENT_SET
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <utility>
+
+namespace concurrency {
+
+  // This class provides a thread-safe, unordered set with most of the same
+  // functionality as std::unordered_set. However, iterator access has been
+  // removed in order to preserve thread-safety, as has find() — membership
+  // is queried with count() or contains(). Iterators have also been
+  // removed from the return type of any function which typically includes
+  // them.
+  //
+  // Serves as the shard type for ShardedUnorderedSet; see
+  // ShardedUnorderedSet.hpp.
+  //
+  // Aside from the above, functions which behave differently than their
+  // std::unordered_set counterpart of the same name are documented with
+  // comments, as are functions that do not exist for std::unordered_set.
+  //
+  // https://en.cppreference.com/w/cpp/container/unordered_set
+  template <class Key, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>, class Allocator = std::allocator<Key>>
+  class UnorderedSet {
+  public:
+    // ------------------------------ Member types ------------------------------ //
+    using mutex_type        = std::shared_mutex;
+    using read_lock         = std::shared_lock<mutex_type>;
+    using write_lock        = std::unique_lock<mutex_type>;
+    using self_type         = UnorderedSet<Key, Hash, Pred, Allocator>;
+    using internal_set_type = std::unordered_set<Key, Hash, Pred, Allocator>;
+    using key_type          = typename internal_set_type::key_type;
+    using value_type        = typename internal_set_type::value_type;
+    using size_type         = typename internal_set_type::size_type;
+    using difference_type   = typename internal_set_type::difference_type;
+    using hasher            = typename internal_set_type::hasher;
+    using key_equal         = typename internal_set_type::key_equal;
+    using allocator_type    = typename internal_set_type::allocator_type;
+
+    // ------------------------------ Constructors ------------------------------ //
+    UnorderedSet() = default;
+    UnorderedSet(const UnorderedSet &other) {
+      auto lock = lock_for_writing();
+      m_set     = other.data();
+      update_size();
+    }
+    UnorderedSet(UnorderedSet &&other) {
+      auto lock = lock_for_writing();
+      m_set     = other.data();
+      update_size();
+    }
+    UnorderedSet(std::initializer_list<value_type> ilist) { insert(ilist); }
+
+    UnorderedSet &operator=(const UnorderedSet &other) {
+      auto lock   = lock_for_writing();
+      this->m_set = other.data();
+      update_size();
+      return *this;
+    }
+    UnorderedSet &operator=(UnorderedSet &&other) noexcept {
+      auto lock   = lock_for_writing();
+      this->m_set = other.data();
+      update_size();
+      return *this;
+    }
+    UnorderedSet &operator=(std::initializer_list<value_type> ilist) {
+      this->insert(ilist);
+      return *this;
+    }
+
+    ~UnorderedSet() = default;
+
+    allocator_type get_allocator() const { return m_set.get_allocator(); }
+
+    // -------------------------------- Capacity -------------------------------- //
+    bool empty() const noexcept {
+      auto lock = lock_for_reading();
+      return m_set.empty();
+    }
+
+    size_type size() const noexcept {
+      auto lock = lock_for_reading();
+      return m_set.size();
+    }
+
+    size_type max_size() const noexcept { return m_set.max_size(); }
+
+    // Returns the number of elements without acquiring a lock; see
+    // UnorderedMap::approx_size for the caveats. This function does not
+    // exist for std::unordered_set.
+    size_type approx_size() const noexcept { return m_size.load(std::memory_order_relaxed); }
+
+    // Lock-free counterpart to empty(), subject to the same caveat as
+    // approx_size().
+    bool approx_empty() const noexcept { return approx_size() == 0; }
+
+    // ------------------------------- Modifiers -------------------------------- //
+    void clear() noexcept {
+      auto lock = lock_for_writing();
+      m_set.clear();
+      update_size();
+    }
+
+    bool insert(const value_type &value) {
+      auto lock = lock_for_writing();
+      bool ret  = m_set.insert(value).second;
+      update_size();
+      return ret;
+    }
+    bool insert(value_type &&value) {
+      auto lock = lock_for_writing();
+      bool ret  = m_set.insert(std::move(value)).second;
+      update_size();
+      return ret;
+    }
+    void insert(std::initializer_list<value_type> ilist) {
+      auto lock = lock_for_writing();
+      m_set.insert(ilist);
+      update_size();
+    }
+
+    template <class... Args>
+    bool emplace(Args &&...args) {
+      auto lock = lock_for_writing();
+      bool ret  = m_set.emplace(std::forward<Args>(args)...).second;
+      update_size();
+      return ret;
+    }
+
+    size_type erase(const Key &key) {
+      auto lock     = lock_for_writing();
+      size_type ret = m_set.erase(key);
+      update_size();
+      return ret;
+    }
+
+    // Erases every element for which the provided predicate returns true,
+    // given a const reference to the element, under a single write lock.
+    // Mirrors std::erase_if. Returns the number of elements erased. This
+    // function does not exist for std::unordered_set.
+    template <class P>
+    size_type erase_if(P &&pred) {
+      auto lock           = lock_for_writing();
+      size_type const old = m_set.size();
+      for (auto it = m_set.begin(); it != m_set.end();) {
+        if (pred(*it)) {
+          it = m_set.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      update_size();
+      return old - m_set.size();
+    }
+
+    void swap(self_type &other) noexcept {
+      if (this == &other) return;
+      // Both locks are taken via std::lock's deadlock-avoidance algorithm
+      // so concurrent a.swap(b) and b.swap(a) cannot deadlock.
+      std::scoped_lock lock(m_mutex, other.m_mutex);
+      this->m_set.swap(other.m_set);
+      this->update_size();
+      other.update_size();
+    }
+
+    void swap(internal_set_type &other) noexcept {
+      auto lock = lock_for_writing();
+      m_set.swap(other);
+      update_size();
+    }
+
+    void merge(internal_set_type &source) {
+      auto lock = lock_for_writing();
+      m_set.merge(source);
+      update_size();
+    }
+    void merge(internal_set_type &&source) {
+      auto lock = lock_for_writing();
+      m_set.merge(source);
+      update_size();
+    }
+    // Splices every element not already present out of source, under
+    // both sets' write locks (taken deadlock-safely, as in swap), in a
+    // single pass of node transfers; conflicting elements stay in
+    // source, as with std merge.
+    void merge(self_type &source) {
+      if (this == &source) return;
+      std::scoped_lock lock(m_mutex, source.m_mutex);
+      m_set.merge(source.m_set);
+      update_size();
+      source.update_size();
+    }
+    void merge(self_type &&source) { merge(source); }
+
+    // ------------------------------ Accessors --------------------------------- //
+    size_type count(const Key &key) const {
+      auto lock = lock_for_reading();
+      return m_set.count(key);
+    }
+
+    // Returns a bool indicating whether or not the provided key is present
+    // in the set. Exists for std::unordered_set only as of C++20.
+    bool contains(const Key &key) const {
+      auto lock = lock_for_reading();
+      return m_set.find(key) != m_set.end();
+    }
+
+    // Invokes the provided callable on a const reference to each element
+    // while holding a read lock, avoiding the full copy that data() makes.
+    // This function does not exist for std::unordered_set.
+    template <class F>
+    void for_each(F &&f) const {
+      auto lock = lock_for_reading();
+      for (auto const &el: m_set) {
+        f(el);
+      }
+    }
+
+    // Returns a non-thread-safe copy of the underlying set.
+    internal_set_type data() const {
+      auto lock = lock_for_reading();
+      return m_set;
+    }
+
+    // ------------------------------ Hash Policy ------------------------------- //
+    float load_factor() const {
+      auto lock = lock_for_reading();
+      return m_set.load_factor();
+    }
+
+    float max_load_factor() const {
+      auto lock = lock_for_reading();
+      return m_set.max_load_factor();
+    }
+
+    void max_load_factor(float ml) {
+      auto lock = lock_for_writing();
+      m_set.max_load_factor(ml);
+    }
+
+    void rehash(size_type count) {
+      auto lock = lock_for_writing();
+      m_set.rehash(count);
+    }
+
+    void reserve(size_type count) {
+      auto lock = lock_for_writing();
+      m_set.reserve(count);
+    }
+
+    // ------------------------------- Observers -------------------------------- //
+    hasher hash_function() const { return m_set.hash_function(); }
+
+    key_equal key_eq() const { return m_set.key_eq(); }
+
+  private:
+    internal_set_type m_set{};
+    mutable mutex_type m_mutex{};
+    std::atomic<size_type> m_size{0};
+
+    read_lock lock_for_reading() const { return read_lock(m_mutex); }
+    write_lock lock_for_writing() { return write_lock(m_mutex); }
+    write_lock lock_for_writing() const { return write_lock(m_mutex); }
+
+    // Must be called by every mutator while holding the write lock, so
+    // approx_size() stays in step with the underlying set.
+    void update_size() { m_size.store(m_set.size(), std::memory_order_relaxed); }
+  };
+
+  template <class Key, class Hash, class KeyEqual, class Alloc>
+  bool operator==(const ::concurrency::UnorderedSet<Key, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::UnorderedSet<Key, Hash, KeyEqual, Alloc> &rhs) {
+    return lhs.data() == rhs.data();
+  }
+
+  template <class Key, class Hash, class KeyEqual, class Alloc>
+  bool operator!=(const ::concurrency::UnorderedSet<Key, Hash, KeyEqual, Alloc> &lhs, const ::concurrency::UnorderedSet<Key, Hash, KeyEqual, Alloc> &rhs) {
+    return !(lhs == rhs);
+  }
+
+  // Specializes the std::swap algorithm for ::concurrency::UnorderedSet. Swaps the contents of lhs and rhs. Calls lhs.swap(rhs).
+  template <class Key, class Hash, class KeyEqual, class Alloc>
+  void swap(::concurrency::UnorderedSet<Key, Hash, KeyEqual, Alloc> &lhs, ::concurrency::UnorderedSet<Key, Hash, KeyEqual, Alloc> &rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+} // namespace concurrency
+#endif // UNORDERED_CONCURRENT_SET
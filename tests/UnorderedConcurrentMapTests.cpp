@@ -1,13 +1,33 @@
+#include <concurrency/AsyncShardedUnorderedMap.hpp>
+#include <concurrency/DynamicShardedUnorderedMap.hpp>
+#include <concurrency/ExpiringShardedUnorderedMap.hpp>
+#include <concurrency/FastHash.hpp>
+#include <concurrency/FlatHashMap.hpp>
+#include <concurrency/PoolAllocator.hpp>
+#include <concurrency/ReadMostlyUnorderedMap.hpp>
 #include <concurrency/ShardedUnorderedMap.hpp>
+#include <concurrency/ShardedUnorderedSet.hpp>
 #include <concurrency/UnorderedMap.hpp>
+#include <concurrency/UnorderedSet.hpp>
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
 
 namespace {
+  using ::concurrency::AsyncShardedUnorderedMap;
+  using ::concurrency::DynamicShardedUnorderedMap;
+  using ::concurrency::ExpiringShardedUnorderedMap;
+  using ::concurrency::ReadMostlyUnorderedMap;
   using ::concurrency::ShardedUnorderedMap;
+  using ::concurrency::ShardedUnorderedSet;
   using ::concurrency::UnorderedMap;
+  using ::concurrency::UnorderedSet;
 
   // Custom struct for use as a map value.
   struct Foo {
@@ -25,6 +45,31 @@ namespace {
     size_t operator()(const Foo &foo) const { return std::hash<int>()(foo.m_a) ^ std::hash<std::string>()(foo.m_b); }
   };
 
+  // Instrumented mapped type for verifying that rvalue modifiers
+  // genuinely move instead of degrading to copies.
+  struct CopyCounted {
+    CopyCounted() = default;
+    explicit CopyCounted(int v) : m_v(v) {}
+    CopyCounted(const CopyCounted &other) : m_v(other.m_v) { ++copies; }
+    CopyCounted(CopyCounted &&other) noexcept : m_v(other.m_v) { ++moves; }
+    CopyCounted &operator=(const CopyCounted &other) {
+      m_v = other.m_v;
+      ++copies;
+      return *this;
+    }
+    CopyCounted &operator=(CopyCounted &&other) noexcept {
+      m_v = other.m_v;
+      ++moves;
+      return *this;
+    }
+
+    static void reset() { copies = moves = 0; }
+
+    int m_v{};
+    static inline int copies = 0;
+    static inline int moves  = 0;
+  };
+
   // helper constant for static_asserts in constexpr flow control.
   template <typename...>
   static inline constexpr bool always_false_v = false;
@@ -85,6 +130,11 @@ namespace {
   class CommonConcurrentUnorderedMapTests : public ::testing::Test {};
   class UnshardedConcurrentUnorderedMapTests : public ::testing::Test {};
   class ShardedConcurrentUnorderedMapTests : public ::testing::Test {};
+  class ReadMostlyUnorderedMapTests : public ::testing::Test {};
+  class DynamicShardedConcurrentUnorderedMapTests : public ::testing::Test {};
+  class ExpiringShardedConcurrentUnorderedMapTests : public ::testing::Test {};
+  class ConcurrentUnorderedSetTests : public ::testing::Test {};
+  class AsyncShardedConcurrentUnorderedMapTests : public ::testing::Test {};
 
   TYPED_TEST_SUITE_P(CommonConcurrentUnorderedMapTests);
   TYPED_TEST_P(CommonConcurrentUnorderedMapTests, DefaultConstructor) {
@@ -190,6 +240,20 @@ namespace {
     ASSERT_LT(0, m.size());
   }
 
+  TYPED_TEST_P(CommonConcurrentUnorderedMapTests, approx_size) {
+    using map_type = TypeParam;
+
+    map_type m;
+    ASSERT_EQ(0, m.approx_size());
+    ASSERT_TRUE(m.approx_empty());
+    m = initialize_test_map<map_type>();
+    ASSERT_EQ(m.size(), m.approx_size());
+    ASSERT_FALSE(m.approx_empty());
+    m.clear();
+    ASSERT_EQ(0, m.approx_size());
+    ASSERT_TRUE(m.approx_empty());
+  }
+
   TYPED_TEST_P(CommonConcurrentUnorderedMapTests, clear) {
     using map_type = TypeParam;
 
@@ -272,14 +336,15 @@ namespace {
     // insert_or_assign(Key &&k, M &&obj)
     {
       map_type m;
-      key_type k;
-      mapped_type v;
+      key_type k    = key_type();
+      mapped_type v = mapped_type();
 
       ASSERT_TRUE(m.empty());
       ASSERT_TRUE(m.insert_or_assign(std::move(k), std::move(v)));
       ASSERT_FALSE(m.empty());
-      ASSERT_FALSE(m.insert_or_assign(std::move(k), std::move(v)));
-      ASSERT_EQ(v, m.at(k));
+      // k and v were genuinely moved from above, so fresh values are used here.
+      ASSERT_FALSE(m.insert_or_assign(key_type(), mapped_type()));
+      ASSERT_EQ(mapped_type(), m.at(key_type()));
     }
   }
 
@@ -619,6 +684,53 @@ namespace {
     }
   }
 
+  TYPED_TEST_P(CommonConcurrentUnorderedMapTests, visit) {
+    using map_type    = TypeParam;
+    using value_type  = typename map_type::value_type;
+    using mapped_type = typename map_type::mapped_type;
+
+    // cvisit(const Key &, F &&)
+    {
+      map_type m;
+      const auto key = value_type().first;
+      ASSERT_FALSE(m.cvisit(key, [](mapped_type const &) { FAIL() << "Callable should not be invoked for an absent key."; }));
+      ASSERT_TRUE(m.insert(value_type()));
+      bool visited = false;
+      ASSERT_TRUE(m.cvisit(key, [&visited](mapped_type const &val) {
+        visited = true;
+        ASSERT_EQ(value_type().second, val);
+      }));
+      ASSERT_TRUE(visited);
+    }
+    // visit(const Key &, F &&)
+    {
+      map_type m      = initialize_test_map<map_type>();
+      const auto data = m.data();
+      const auto key  = data.begin()->first;
+      ASSERT_TRUE(m.visit(key, [](mapped_type &val) { val = mapped_type(); }));
+      ASSERT_EQ(mapped_type(), m.at(key));
+      m.clear();
+      ASSERT_FALSE(m.visit(key, [](mapped_type &) { FAIL() << "Callable should not be invoked for an absent key."; }));
+    }
+  }
+
+  TYPED_TEST_P(CommonConcurrentUnorderedMapTests, get_or_insert) {
+    using map_type    = TypeParam;
+    using value_type  = typename map_type::value_type;
+    using mapped_type = typename map_type::mapped_type;
+
+    map_type m;
+    const auto key = value_type().first;
+    ASSERT_TRUE(m.empty());
+    ASSERT_EQ(mapped_type(), m.get_or_insert(key, []() { return mapped_type(); }));
+    ASSERT_EQ(1, m.size());
+    ASSERT_EQ(mapped_type(), m.get_or_insert(key, []() -> mapped_type {
+      [] { FAIL() << "Factory should not be invoked for a present key."; }();
+      return mapped_type();
+    }));
+    ASSERT_EQ(1, m.size());
+  }
+
   TYPED_TEST_P(CommonConcurrentUnorderedMapTests, count) {
     using map_type   = TypeParam;
     using value_type = typename map_type::value_type;
@@ -664,6 +776,49 @@ namespace {
     }
   }
 
+  TYPED_TEST_P(CommonConcurrentUnorderedMapTests, for_each) {
+    using map_type   = TypeParam;
+    using value_type = typename map_type::value_type;
+
+    map_type m               = initialize_test_map<map_type>();
+    auto const expected      = m.data();
+    typename map_type::size_type visited = 0;
+    m.for_each([&expected, &visited](value_type const &el) {
+      ++visited;
+      ASSERT_NE(expected.end(), expected.find(el.first));
+      ASSERT_EQ(expected.at(el.first), el.second);
+    });
+    ASSERT_EQ(expected.size(), visited);
+  }
+
+  TYPED_TEST_P(CommonConcurrentUnorderedMapTests, erase_if) {
+    using map_type   = TypeParam;
+    using value_type = typename map_type::value_type;
+
+    map_type m          = initialize_test_map<map_type>();
+    auto const expected = m.data();
+
+    // count_if / any_of against a known key.
+    auto const probe = expected.begin()->first;
+    ASSERT_EQ(1, m.count_if([&probe](value_type const &el) { return el.first == probe; }));
+    ASSERT_EQ(expected.size(), m.count_if([](value_type const &) { return true; }));
+    ASSERT_TRUE(m.any_of([&probe](value_type const &el) { return el.first == probe; }));
+    ASSERT_FALSE(m.any_of([](value_type const &) { return false; }));
+
+    // Erase just the probed element, then everything.
+    ASSERT_EQ(1, m.erase_if([&probe](value_type const &el) { return el.first == probe; }));
+    ASSERT_EQ(expected.size() - 1, m.size());
+    ASSERT_FALSE(m.find(probe));
+    for (auto const &el: expected) {
+      if (el.first == probe) continue;
+      ASSERT_TRUE(m.find(el.first));
+    }
+    ASSERT_EQ(0, m.erase_if([](value_type const &) { return false; }));
+    ASSERT_EQ(expected.size() - 1, m.erase_if([](value_type const &) { return true; }));
+    ASSERT_TRUE(m.empty());
+    ASSERT_FALSE(m.any_of([](value_type const &) { return true; }));
+  }
+
   TYPED_TEST_P(CommonConcurrentUnorderedMapTests, load_factor) {
     using map_type = TypeParam;
 
@@ -742,18 +897,23 @@ namespace {
                               get_allocator,                     //
                               empty,                             //
                               size,                              //
+                              approx_size,                       //
                               clear,                             //
                               insert,                            //
                               insert_or_assign,                  //
                               erase,                             //
+                              erase_if,                          //
                               swap,                              //
                               extract,                           //
                               merge,                             //
                               at,                                //
                               subscript,                         //
+                              visit,                             //
+                              get_or_insert,                     //
                               count,                             //
                               find,                              //
                               data,                              //
+                              for_each,                          //
                               load_factor,                       //
                               max_load_factor,                   //
                               rehash,                            //
@@ -782,7 +942,10 @@ namespace {
       ShardedUnorderedMap<int32_t, std::string>,                                               //
       ShardedUnorderedMap<int64_t, std::string>,                                               //
       ShardedUnorderedMap<Foo, int16_t, ::concurrency::DefaultUnorderedMapShardCount, FooHash>, //
-      ShardedUnorderedMap<int16_t, Foo>>;                                                      //
+      ShardedUnorderedMap<int16_t, Foo>,                                                       //
+      DynamicShardedUnorderedMap<std::string, uint32_t>,                                       //
+      DynamicShardedUnorderedMap<int32_t, std::string>,                                        //
+      DynamicShardedUnorderedMap<int16_t, Foo>>;                                               //
 
   INSTANTIATE_TYPED_TEST_SUITE_P(TypedTests, CommonConcurrentUnorderedMapTests, Types);
 
@@ -840,6 +1003,76 @@ namespace {
     ASSERT_EQ("quuux", umap.at("baz"));
   }
 
+  TEST_F(UnshardedConcurrentUnorderedMapTests, insert_range) {
+    using map_type = UnorderedMap<std::string, uint32_t>;
+
+    auto const init = initialize_test_map<map_type>().data();
+    std::vector<map_type::value_type> values(init.begin(), init.end());
+    map_type m;
+    ASSERT_TRUE(m.empty());
+    ASSERT_EQ(values.size(), m.insert(values.begin(), values.end()));
+    ASSERT_EQ(values.size(), m.size());
+    ASSERT_EQ(0, m.insert(values.begin(), values.end())) << "Expected no elements to be inserted for existing keys.";
+    for (auto const &[key, val]: values) {
+      ASSERT_EQ(val, m.at(key));
+    }
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, insert_batch) {
+    using map_type = ShardedUnorderedMap<int32_t, int32_t>;
+
+    std::vector<map_type::value_type> values;
+    for (int32_t i = 0; i < 1000; ++i) {
+      values.push_back({i, i * 2});
+    }
+    map_type m;
+    ASSERT_TRUE(m.empty());
+    ASSERT_EQ(values.size(), m.insert_batch(values.begin(), values.end()));
+    ASSERT_EQ(values.size(), m.size());
+    ASSERT_EQ(0, m.insert_batch(values)) << "Expected no elements to be inserted for existing keys.";
+    for (auto const &[key, val]: values) {
+      ASSERT_EQ(val, m.at(key));
+    }
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, find_many) {
+    using map_type = UnorderedMap<std::string, uint32_t>;
+
+    auto m = initialize_test_map<map_type>();
+    std::vector<std::string> const keys{"foo", "nope", "baz"};
+    std::vector<std::optional<uint32_t>> results;
+    ASSERT_EQ(2, m.find_many(keys.begin(), keys.end(), std::back_inserter(results)));
+    ASSERT_EQ(keys.size(), results.size());
+    ASSERT_TRUE(results[0].has_value());
+    ASSERT_EQ(m.at("foo"), results[0].value());
+    ASSERT_FALSE(results[1].has_value());
+    ASSERT_TRUE(results[2].has_value());
+    ASSERT_EQ(m.at("baz"), results[2].value());
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, find_many) {
+    using map_type = ShardedUnorderedMap<int32_t, int32_t>;
+
+    map_type m;
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_TRUE(m.insert({i, i * 3}));
+    }
+    std::vector<int32_t> keys;
+    for (int32_t i = 0; i < 200; ++i) {
+      keys.push_back(i);
+    }
+    auto const results = m.find_many(keys);
+    ASSERT_EQ(keys.size(), results.size());
+    for (int32_t i = 0; i < 200; ++i) {
+      if (i < 100) {
+        ASSERT_TRUE(results[i].has_value());
+        ASSERT_EQ(i * 3, results[i].value());
+      } else {
+        ASSERT_FALSE(results[i].has_value());
+      }
+    }
+  }
+
   TEST_F(UnshardedConcurrentUnorderedMapTests, max_size) {
     UnorderedMap<std::string, std::string> umap;
     ASSERT_LT(0, umap.max_size());
@@ -874,9 +1107,92 @@ namespace {
       int val1         = 1;
       std::string val2 = "bar";
       ASSERT_TRUE(umap.try_emplace(std::move(key), std::move(val1), std::move(val2)));
-      ASSERT_FALSE(umap.try_emplace(std::move(key), std::move(val1), std::move(val2)));
+      // key and val2 were genuinely moved from above, so fresh values are used here.
+      ASSERT_FALSE(umap.try_emplace("foo", 1, "baz"));
+      ASSERT_EQ(Foo(1, "bar"), umap["foo"]);
+    }
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, emplace) {
+    ShardedUnorderedMap<std::string, std::string> umap;
+    ASSERT_TRUE(umap.empty());
+    ASSERT_TRUE(umap.emplace("foo", "bar"));
+    ASSERT_FALSE(umap.emplace("foo", "baz"));
+    ASSERT_EQ("bar", umap["foo"]);
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, try_emplace) {
+    // try_emplace(const Key &k, Args &&...args)
+    {
+      ShardedUnorderedMap<std::string, Foo> umap;
+      ASSERT_TRUE(umap.empty());
+      std::string key  = "foo";
+      int val1         = 1;
+      std::string val2 = "bar";
+      ASSERT_TRUE(umap.try_emplace(key, val1, val2));
+      ASSERT_FALSE(umap.try_emplace(key, val1, val2));
       ASSERT_EQ(Foo(val1, val2), umap["foo"]);
     }
+
+    // try_emplace(Key &&k, Args &&...args)
+    {
+      ShardedUnorderedMap<std::string, Foo> umap;
+      ASSERT_TRUE(umap.empty());
+      std::string key  = "foo";
+      int val1         = 1;
+      std::string val2 = "bar";
+      ASSERT_TRUE(umap.try_emplace(std::move(key), std::move(val1), std::move(val2)));
+      // key and val2 were genuinely moved from above, so fresh values are used here.
+      ASSERT_FALSE(umap.try_emplace("foo", 1, "baz"));
+      ASSERT_EQ(Foo(1, "bar"), umap["foo"]);
+    }
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, emplace_move_only_mapped_type) {
+    ShardedUnorderedMap<int32_t, std::unique_ptr<int32_t>> umap;
+    ASSERT_TRUE(umap.emplace(1, std::make_unique<int32_t>(42)));
+    ASSERT_TRUE(umap.try_emplace(2, std::make_unique<int32_t>(43)));
+    ASSERT_FALSE(umap.try_emplace(2, std::make_unique<int32_t>(44)));
+    bool visited = false;
+    ASSERT_TRUE(umap.cvisit(1, [&visited](std::unique_ptr<int32_t> const &val) {
+      visited = true;
+      ASSERT_EQ(42, *val);
+    }));
+    ASSERT_TRUE(visited);
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, rvalue_modifiers_do_not_copy) {
+    UnorderedMap<int32_t, CopyCounted> umap;
+    CopyCounted::reset();
+    ASSERT_TRUE(umap.insert({1, CopyCounted(1)}));
+    ASSERT_TRUE(umap.insert_or_assign(2, CopyCounted(2)));
+    ASSERT_FALSE(umap.insert_or_assign(2, CopyCounted(22)));
+    ASSERT_TRUE(umap.assign(2, CopyCounted(222)));
+    ASSERT_FALSE(umap.assign(3, CopyCounted(3)));
+    ASSERT_EQ(0, CopyCounted::copies) << "Expected rvalue modifiers to move, not copy.";
+    bool visited = false;
+    umap.cvisit(2, [&visited](CopyCounted const &val) {
+      visited = true;
+      ASSERT_EQ(222, val.m_v);
+    });
+    ASSERT_TRUE(visited);
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, rvalue_modifiers_do_not_copy) {
+    ShardedUnorderedMap<int32_t, CopyCounted> umap;
+    CopyCounted::reset();
+    ASSERT_TRUE(umap.insert({1, CopyCounted(1)}));
+    ASSERT_TRUE(umap.insert_or_assign(2, CopyCounted(2)));
+    ASSERT_FALSE(umap.insert_or_assign(2, CopyCounted(22)));
+    ASSERT_TRUE(umap.assign(2, CopyCounted(222)));
+    ASSERT_FALSE(umap.assign(3, CopyCounted(3)));
+    ASSERT_EQ(0, CopyCounted::copies) << "Expected rvalue modifiers to move, not copy.";
+    bool visited = false;
+    umap.cvisit(2, [&visited](CopyCounted const &val) {
+      visited = true;
+      ASSERT_EQ(222, val.m_v);
+    });
+    ASSERT_TRUE(visited);
   }
 
   TEST_F(UnshardedConcurrentUnorderedMapTests, bucket_count) {
@@ -906,6 +1222,115 @@ namespace {
     ASSERT_LE(0, m.bucket("foo"));
   }
 
+  TEST_F(ShardedConcurrentUnorderedMapTests, for_each_parallel) {
+    using map_type = ShardedUnorderedMap<int32_t, int32_t>;
+
+    map_type m;
+    constexpr int32_t element_count = 1000;
+    for (int32_t i = 0; i < element_count; ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+    std::atomic<int32_t> visited = 0;
+    m.for_each([&visited](map_type::value_type const &el) { visited += el.second == el.first ? 1 : 0; }, 4);
+    ASSERT_EQ(element_count, visited);
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, for_each_shard) {
+    using map_type = ShardedUnorderedMap<int32_t, int32_t>;
+
+    map_type m;
+    constexpr int32_t element_count = 1000;
+    for (int32_t i = 0; i < element_count; ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+    uint32_t shards_visited        = 0;
+    map_type::size_type total_size = 0;
+    m.for_each_shard([&shards_visited, &total_size](uint32_t const idx, map_type::shard_type const &shard) {
+      ASSERT_EQ(shards_visited, idx);
+      ++shards_visited;
+      total_size += shard.size();
+    });
+    ASSERT_EQ(m.shard_count(), shards_visited);
+    ASSERT_EQ(m.size(), total_size);
+  }
+
+  TEST_F(ReadMostlyUnorderedMapTests, Modifiers) {
+    ReadMostlyUnorderedMap<std::string, uint32_t> umap{
+        {"foo", 1},
+        {"bar", 2},
+    };
+    ASSERT_FALSE(umap.empty());
+    ASSERT_EQ(2, umap.size());
+    ASSERT_TRUE(umap.insert({"baz", 3}));
+    ASSERT_FALSE(umap.insert({"baz", 4}));
+    ASSERT_EQ(3, umap.at("baz"));
+    ASSERT_FALSE(umap.insert_or_assign("baz", 4));
+    ASSERT_EQ(4, umap.at("baz"));
+    ASSERT_EQ(1, umap.erase("baz"));
+    ASSERT_EQ(0, umap.erase("baz"));
+    umap.clear();
+    ASSERT_TRUE(umap.empty());
+  }
+
+  TEST_F(ReadMostlyUnorderedMapTests, Accessors) {
+    ReadMostlyUnorderedMap<std::string, uint32_t> umap{
+        {"foo", 1},
+        {"bar", 2},
+    };
+    ASSERT_TRUE(umap.find("foo"));
+    ASSERT_FALSE(umap.find("baz"));
+    ASSERT_EQ(1, umap.count("foo"));
+    ASSERT_EQ(1, umap.at("foo"));
+    bool visited = false;
+    ASSERT_TRUE(umap.cvisit("bar", [&visited](uint32_t const &val) {
+      visited = true;
+      ASSERT_EQ(2, val);
+    }));
+    ASSERT_TRUE(visited);
+    ASSERT_FALSE(umap.cvisit("baz", [](uint32_t const &) { FAIL() << "Callable should not be invoked for an absent key."; }));
+    uint32_t sum = 0;
+    umap.for_each([&sum](auto const &el) { sum += el.second; });
+    ASSERT_EQ(3, sum);
+    auto data = umap.data();
+    ASSERT_EQ(2, data.size());
+    ASSERT_EQ(umap, (ReadMostlyUnorderedMap<std::string, uint32_t>{{"foo", 1}, {"bar", 2}}));
+    ASSERT_NE(umap, (ReadMostlyUnorderedMap<std::string, uint32_t>{}));
+  }
+
+  TEST_F(ReadMostlyUnorderedMapTests, ConcurrentReadersDuringWrites) {
+    ReadMostlyUnorderedMap<int32_t, int32_t> umap;
+    constexpr int32_t key_space = 100;
+    for (int32_t i = 0; i < key_space; ++i) {
+      ASSERT_TRUE(umap.insert({i, i}));
+    }
+    std::atomic<bool> stop     = false;
+    std::atomic<bool> mismatch = false;
+    std::vector<std::thread> readers;
+    for (uint32_t t = 0; t < 4; ++t) {
+      readers.emplace_back([&umap, &stop, &mismatch]() {
+        while (!stop) {
+          for (int32_t i = 0; i < key_space; ++i) {
+            // Values are only ever overwritten with themselves, so a
+            // reader must always observe val == key on a present key.
+            umap.cvisit(i, [&mismatch, i](int32_t const &val) {
+              if (val != i) mismatch = true;
+            });
+          }
+        }
+      });
+    }
+    for (int32_t round = 0; round < 100; ++round) {
+      for (int32_t i = 0; i < key_space; ++i) {
+        umap.insert_or_assign(i, i);
+      }
+    }
+    stop = true;
+    for (auto &r: readers) {
+      r.join();
+    }
+    ASSERT_FALSE(mismatch);
+  }
+
   TEST_F(ShardedConcurrentUnorderedMapTests, shard_count) {
     ShardedUnorderedMap<std::string, std::string, ::concurrency::DefaultUnorderedMapShardCount> umap{
         {"foo", "qux"},
@@ -916,10 +1341,909 @@ namespace {
     ASSERT_EQ(::concurrency::DefaultUnorderedMapShardCount, umap.shard_count());
   }
 
+  TEST_F(ShardedConcurrentUnorderedMapTests, snapshot) {
+    using map_type = ShardedUnorderedMap<int32_t, int32_t>;
+
+    map_type m;
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(m.insert({i, i * 7}));
+    }
+    uint32_t shards_streamed = 0;
+    map_type::internal_map_type combined;
+    auto const streamed = m.snapshot([&shards_streamed, &combined](uint32_t const idx, map_type::internal_map_type &&shard_data) {
+      ASSERT_EQ(shards_streamed, idx);
+      ++shards_streamed;
+      combined.merge(shard_data);
+    });
+    ASSERT_EQ(m.shard_count(), shards_streamed);
+    ASSERT_EQ(m.size(), streamed);
+    ASSERT_EQ(m.data(), combined);
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, reserve_total) {
+    using map_type = ShardedUnorderedMap<int32_t, int32_t>;
+
+    constexpr map_type::size_type total = 10'000;
+    map_type m;
+    m.reserve_total(total);
+    // Each shard should be sized for roughly its share of the total, not
+    // for the full total.
+    map_type::size_type total_buckets = 0;
+    m.for_each_shard([&total_buckets](uint32_t, map_type::shard_type const &shard) { total_buckets += shard.bucket_count(); });
+    ASSERT_GE(total_buckets, total / 2) << "Expected capacity for roughly the requested total.";
+    ASSERT_LT(total_buckets, total * 4) << "Expected far less than ShardCount times the requested total.";
+    for (int32_t i = 0; i < static_cast<int32_t>(total); ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+    ASSERT_EQ(total, m.size());
+    m.rehash_total(total * 2);
+    ASSERT_EQ(total, m.size());
+  }
+
   TEST_F(ShardedConcurrentUnorderedMapTests, shard_load_factor) {
     ShardedUnorderedMap<std::string, std::string, ::concurrency::DefaultUnorderedMapShardCount> umap;
     for (uint32_t i = 0; i < ::concurrency::DefaultUnorderedMapShardCount; ++i) {
       ASSERT_NEAR(0, umap.shard_load_factor(i), 0.0001);
     }
   }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, fetch_add) {
+    UnorderedMap<std::string, int64_t> m;
+    // Absent keys are default-constructed before the add.
+    ASSERT_EQ(5, m.fetch_add("ctr", 5));
+    ASSERT_EQ(7, m.fetch_add("ctr", 2));
+    ASSERT_EQ(2, m.fetch_add("ctr", -5));
+    ASSERT_EQ(2, m.at("ctr"));
+    ASSERT_EQ(1, m.size());
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, fetch_add) {
+    ShardedUnorderedMap<int32_t, int64_t> m;
+    constexpr int32_t num_threads    = 8;
+    constexpr int64_t adds_per_thread = 1000;
+    // Every increment is a single-lock read-modify-write, so concurrent
+    // adds to the same key must never be lost.
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&m, t]() {
+        for (int64_t i = 0; i < adds_per_thread; ++i) {
+          (void) m.fetch_add(42, 1);
+          (void) m.fetch_add(t, 1);
+        }
+      });
+    }
+    for (auto &t: threads) {
+      t.join();
+    }
+    ASSERT_EQ(num_threads * adds_per_thread, m.at(42));
+    for (int32_t t = 0; t < num_threads; ++t) {
+      if (t == 42) continue;
+      ASSERT_EQ(adds_per_thread, m.at(t));
+    }
+  }
+
+  TEST_F(DynamicShardedConcurrentUnorderedMapTests, fetch_add) {
+    DynamicShardedUnorderedMap<std::string, uint64_t> m(4);
+    ASSERT_EQ(3, m.fetch_add("a", 3));
+    ASSERT_EQ(6, m.fetch_add("a", 3));
+    ASSERT_EQ(1, m.fetch_add("b", 1));
+    ASSERT_EQ(2, m.size());
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, bloom_filter_skips_lock_on_miss) {
+    using map_type = UnorderedMap<std::string, int32_t, std::hash<std::string>, std::equal_to<std::string>, std::allocator<std::pair<const std::string, int32_t>>,
+                                  ::concurrency::UnorderedMapStatsPolicy, ::concurrency::NodeBackend, ::concurrency::BloomUnorderedMapFilterPolicy<>>;
+    map_type m;
+    ASSERT_TRUE(m.insert({"present", 1}));
+    auto const before = m.stats().read_lock_acquisitions;
+    // A definite miss answers from the filter without ever taking the
+    // read lock.
+    ASSERT_FALSE(m.find("absent"));
+    ASSERT_EQ(0, m.count("absent"));
+    ASSERT_EQ(before, m.stats().read_lock_acquisitions);
+    // Hits still go through the locked probe.
+    ASSERT_TRUE(m.find("present"));
+    ASSERT_GT(m.stats().read_lock_acquisitions, before);
+    ASSERT_EQ(1, m.at("present"));
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, bloom_filter_stays_correct_through_erases) {
+    // 64 filter bits force a rebuild every 4 erases and make false
+    // positives routine; answers must stay correct regardless.
+    using map_type = UnorderedMap<int32_t, int32_t, std::hash<int32_t>, std::equal_to<int32_t>, std::allocator<std::pair<const int32_t, int32_t>>,
+                                  ::concurrency::NullUnorderedMapStatsPolicy, ::concurrency::NodeBackend, ::concurrency::BloomUnorderedMapFilterPolicy<64>>;
+    map_type m;
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+    for (int32_t i = 0; i < 100; i += 2) {
+      ASSERT_EQ(1, m.erase(i));
+    }
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_EQ(i % 2 != 0, m.find(i));
+    }
+    m.clear();
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_FALSE(m.find(i));
+    }
+    ASSERT_TRUE(m.insert({42, 42}));
+    ASSERT_TRUE(m.find(42));
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, bloom_filter_concurrent_misses) {
+    using map_type = ShardedUnorderedMap<int32_t, int32_t, ::concurrency::DefaultUnorderedMapShardCount, std::hash<int32_t>, std::equal_to<int32_t>,
+                                         std::allocator<std::pair<const int32_t, int32_t>>, ::concurrency::NullUnorderedMapStatsPolicy, ::concurrency::NodeBackend,
+                                         ::concurrency::BloomUnorderedMapFilterPolicy<4096>>;
+    map_type m;
+    constexpr int32_t keys = 2000;
+    std::thread writer([&m]() {
+      for (int32_t i = 0; i < keys; ++i) {
+        ASSERT_TRUE(m.insert({i, i}));
+      }
+    });
+    // Probe far outside the writer's key range while it runs; the filter
+    // must never fabricate a hit for keys that were never inserted.
+    std::vector<std::thread> readers;
+    for (int32_t t = 0; t < 4; ++t) {
+      readers.emplace_back([&m]() {
+        for (int32_t i = keys; i < 2 * keys; ++i) {
+          ASSERT_FALSE(m.find(i));
+        }
+      });
+    }
+    writer.join();
+    for (auto &t: readers) {
+      t.join();
+    }
+    for (int32_t i = 0; i < keys; ++i) {
+      ASSERT_TRUE(m.find(i));
+      ASSERT_EQ(i, m.at(i));
+    }
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, memory_usage) {
+    UnorderedMap<int32_t, int64_t> m;
+    auto const empty_bytes = m.memory_usage();
+    ASSERT_GE(empty_bytes, sizeof(m));
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+    // The estimate must at least cover the element payload.
+    ASSERT_GT(m.memory_usage(), empty_bytes + 1000 * sizeof(std::pair<const int32_t, int64_t>));
+
+    // The flat backend reports its storage exactly: capacity slots plus
+    // one control byte per slot, plus the map objects themselves.
+    UnorderedMap<int32_t, int64_t, std::hash<int32_t>, std::equal_to<int32_t>, std::allocator<std::pair<const int32_t, int64_t>>, ::concurrency::NullUnorderedMapStatsPolicy,
+                 ::concurrency::FlatBackend>
+        flat;
+    ASSERT_TRUE(flat.insert({1, 1}));
+    auto const expected = flat.bucket_count() * (sizeof(std::pair<const int32_t, int64_t>) + 1);
+    ASSERT_GT(flat.memory_usage(), expected);
+    ASSERT_LE(flat.memory_usage(), expected + sizeof(flat));
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, memory_usage) {
+    ShardedUnorderedMap<int32_t, int64_t> m;
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+    ShardedUnorderedMap<int32_t, int64_t>::size_type bucket_sum = 0;
+    ShardedUnorderedMap<int32_t, int64_t>::size_type byte_sum   = 0;
+    for (uint32_t i = 0; i < m.shard_count(); ++i) {
+      bucket_sum += m.shard_bucket_count(i);
+      byte_sum += m.shard_memory_usage(i);
+    }
+    // The whole-map figures are exactly the per-shard sums.
+    ASSERT_EQ(bucket_sum, m.bucket_count());
+    ASSERT_EQ(byte_sum, m.memory_usage());
+    ASSERT_GT(m.memory_usage(), 1000 * sizeof(std::pair<const int32_t, int64_t>));
+    ASSERT_THROW((void) m.shard_bucket_count(m.shard_count()), std::out_of_range);
+    ASSERT_THROW((void) m.shard_memory_usage(m.shard_count()), std::out_of_range);
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, merge_self_shard_pairwise) {
+    ShardedUnorderedMap<int32_t, std::string> dst;
+    ShardedUnorderedMap<int32_t, std::string> src;
+    constexpr int32_t total = 1000;
+    for (int32_t i = 0; i < total; ++i) {
+      ASSERT_TRUE(src.insert({i, "src"}));
+    }
+    // Conflicting keys must stay behind in source, as with std merge.
+    ASSERT_TRUE(dst.insert({0, "dst"}));
+    ASSERT_TRUE(dst.insert({1, "dst"}));
+    dst.merge(src);
+    ASSERT_EQ(total, dst.size());
+    ASSERT_EQ(2, src.size());
+    ASSERT_EQ("dst", dst.at(0));
+    ASSERT_EQ("dst", dst.at(1));
+    ASSERT_EQ("src", src.at(0));
+    ASSERT_EQ("src", src.at(1));
+    ASSERT_EQ("src", dst.at(2));
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, concurrent_swap_no_deadlock) {
+    UnorderedMap<int32_t, int32_t> a{{1, 1}};
+    UnorderedMap<int32_t, int32_t> b{{2, 2}};
+    constexpr int32_t swaps_per_thread = 10'000;
+    // Opposite-direction swaps lock both maps; the locks are taken with
+    // deadlock avoidance, so this must run to completion.
+    std::thread t1([&]() {
+      for (int32_t i = 0; i < swaps_per_thread; ++i) a.swap(b);
+    });
+    std::thread t2([&]() {
+      for (int32_t i = 0; i < swaps_per_thread; ++i) b.swap(a);
+    });
+    t1.join();
+    t2.join();
+    ASSERT_EQ(1, a.size());
+    ASSERT_EQ(1, b.size());
+    ASSERT_EQ(2, a.size() + b.size());
+  }
+
+  TEST_F(ConcurrentUnorderedSetTests, unsharded_basics) {
+    UnorderedSet<std::string> s;
+    ASSERT_TRUE(s.empty());
+    ASSERT_TRUE(s.insert("foo"));
+    ASSERT_FALSE(s.insert("foo"));
+    ASSERT_TRUE(s.emplace("bar"));
+    s.insert({"baz", "qux"});
+    ASSERT_EQ(4, s.size());
+    ASSERT_EQ(4, s.approx_size());
+    ASSERT_TRUE(s.contains("bar"));
+    ASSERT_EQ(1, s.count("baz"));
+    ASSERT_EQ(1, s.erase("bar"));
+    ASSERT_EQ(0, s.erase("bar"));
+    ASSERT_FALSE(s.contains("bar"));
+    ASSERT_EQ(1, s.erase_if([](std::string const &el) { return el == "qux"; }));
+    auto const contents = s.data();
+    ASSERT_EQ(2, contents.size());
+    ASSERT_EQ(1, contents.count("foo"));
+    ASSERT_EQ(1, contents.count("baz"));
+
+    UnorderedSet<std::string> other{"foo", "extra"};
+    s.merge(other);
+    ASSERT_TRUE(s.contains("extra"));
+    ASSERT_EQ(3, s.size());
+    // Keys already present stay behind in the source, as with std merge.
+    ASSERT_TRUE(other.contains("foo"));
+    ASSERT_FALSE(other.contains("extra"));
+
+    s.clear();
+    ASSERT_TRUE(s.empty());
+    ASSERT_TRUE(s.approx_empty());
+  }
+
+  TEST_F(ConcurrentUnorderedSetTests, sharded_basics) {
+    ShardedUnorderedSet<int32_t, 8> s;
+    ASSERT_EQ(8, s.shard_count());
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_TRUE(s.insert(i));
+    }
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_FALSE(s.insert(i));
+      ASSERT_TRUE(s.contains(i));
+    }
+    ASSERT_EQ(100, s.size());
+    ASSERT_EQ(100, s.approx_size());
+    ASSERT_EQ(50, s.erase_if([](int32_t const el) { return el % 2 == 0; }));
+    ASSERT_EQ(50, s.size());
+    ASSERT_FALSE(s.contains(2));
+    ASSERT_TRUE(s.contains(3));
+    ASSERT_EQ(50, s.data().size());
+
+    std::unordered_set<int32_t> loose{3, 1000};
+    s.merge(loose);
+    ASSERT_TRUE(s.contains(1000));
+    ASSERT_EQ(1, loose.size()); // 3 was already present and stays behind.
+
+    ShardedUnorderedSet<int32_t, 8> copy(s);
+    ASSERT_EQ(copy, s);
+    ASSERT_EQ(1, s.erase(1000));
+    ASSERT_NE(copy, s);
+  }
+
+  TEST_F(ConcurrentUnorderedSetTests, sharded_concurrent_dedup) {
+    // Overlapping concurrent inserts must deduplicate down to the key
+    // space, the dedup-stage pattern this container exists for.
+    ShardedUnorderedSet<int32_t> s;
+    constexpr int32_t key_space   = 500;
+    constexpr int32_t num_threads = 8;
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&s]() {
+        for (int32_t i = 0; i < key_space; ++i) {
+          (void) s.insert(i);
+        }
+      });
+    }
+    for (auto &t: threads) {
+      t.join();
+    }
+    ASSERT_EQ(key_space, s.size());
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, serialize_round_trip) {
+    ShardedUnorderedMap<int64_t, uint32_t> m;
+    for (int64_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(m.insert({i, static_cast<uint32_t>(i * 3)}));
+    }
+
+    std::stringstream snapshot;
+    m.serialize(snapshot);
+
+    // Restore replaces any existing contents.
+    ShardedUnorderedMap<int64_t, uint32_t> restored;
+    ASSERT_TRUE(restored.insert({-1, 42}));
+    restored.deserialize(snapshot);
+    ASSERT_EQ(m, restored);
+    ASSERT_FALSE(restored.find(-1));
+    ASSERT_EQ(1000, restored.size());
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, serialize_round_trip_strings) {
+    ShardedUnorderedMap<std::string, std::string> m;
+    for (int32_t i = 0; i < 200; ++i) {
+      ASSERT_TRUE(m.insert({"key" + std::to_string(i), std::string(i, 'x')}));
+    }
+    ASSERT_TRUE(m.insert({"", "empty key"}));
+
+    std::stringstream snapshot;
+    m.serialize(snapshot);
+    ShardedUnorderedMap<std::string, std::string> restored;
+    restored.deserialize(snapshot);
+    ASSERT_EQ(m, restored);
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, deserialize_rejects_bad_input) {
+    ShardedUnorderedMap<int32_t, int32_t, 8> m;
+    ASSERT_TRUE(m.insert({1, 2}));
+    std::stringstream snapshot;
+    m.serialize(snapshot);
+
+    // The partition depends on ShardCount, so a snapshot written with a
+    // different count must be rejected rather than mis-sharded.
+    ShardedUnorderedMap<int32_t, int32_t, 16> wrong_count;
+    ASSERT_THROW(wrong_count.deserialize(snapshot), std::runtime_error);
+
+    std::stringstream garbage("definitely not a snapshot");
+    ShardedUnorderedMap<int32_t, int32_t, 8> restored;
+    ASSERT_THROW(restored.deserialize(garbage), std::runtime_error);
+
+    // Truncated stream: drop the tail of a valid snapshot.
+    std::stringstream full;
+    m.serialize(full);
+    std::string const bytes = full.str();
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 4));
+    ASSERT_THROW(restored.deserialize(truncated), std::runtime_error);
+  }
+
+  TEST_F(ExpiringShardedConcurrentUnorderedMapTests, expiry_basics) {
+    ExpiringShardedUnorderedMap<std::string, int32_t> m(std::chrono::seconds(10));
+    ASSERT_TRUE(m.insert("live", 1));
+    ASSERT_FALSE(m.insert("live", 2));
+    ASSERT_EQ(1, m.at("live"));
+    ASSERT_EQ(1, m.count("live"));
+    ASSERT_TRUE(m.insert("doomed", 3, std::chrono::milliseconds(1)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // The expired entry reads as absent but is still physically stored
+    // until a write or sweep reclaims it.
+    ASSERT_FALSE(m.find("doomed"));
+    ASSERT_EQ(0, m.count("doomed"));
+    ASSERT_THROW((void) m.at("doomed"), std::out_of_range);
+    ASSERT_EQ(1, m.size());
+    ASSERT_EQ(2, m.stored_size());
+
+    // Insertion over an expired entry reclaims it in place.
+    ASSERT_TRUE(m.insert("doomed", 4));
+    ASSERT_EQ(4, m.at("doomed"));
+    ASSERT_EQ(2, m.size());
+    ASSERT_EQ(2, m.stored_size());
+
+    // insert_or_assign reports whether a live entry was replaced.
+    ASSERT_FALSE(m.insert_or_assign("doomed", 5));
+    ASSERT_EQ(5, m.at("doomed"));
+
+    // erase reports 1 only for live entries.
+    ASSERT_EQ(1, m.erase("doomed"));
+    ASSERT_EQ(0, m.erase("doomed"));
+
+    auto const live = m.data();
+    ASSERT_EQ(1, live.size());
+    ASSERT_EQ(1, live.at("live"));
+  }
+
+  TEST_F(ExpiringShardedConcurrentUnorderedMapTests, touch_and_ttl) {
+    ExpiringShardedUnorderedMap<int32_t, int32_t> m(std::chrono::seconds(10));
+    ASSERT_TRUE(m.insert(1, 100));
+    auto const remaining = m.ttl(1);
+    ASSERT_TRUE(remaining.has_value());
+    ASSERT_GT(*remaining, std::chrono::seconds(0));
+    ASSERT_LE(*remaining, std::chrono::seconds(10));
+
+    // touch resets the deadline without changing the value.
+    ASSERT_TRUE(m.touch(1, std::chrono::hours(1)));
+    ASSERT_GT(*m.ttl(1), std::chrono::minutes(59));
+    ASSERT_EQ(100, m.at(1));
+
+    // Touching an expired entry fails and reclaims it.
+    ASSERT_TRUE(m.insert(2, 200, std::chrono::milliseconds(1)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_FALSE(m.touch(2));
+    ASSERT_EQ(1, m.stored_size());
+    ASSERT_FALSE(m.ttl(2).has_value());
+    ASSERT_FALSE(m.touch(3));
+  }
+
+  TEST_F(ExpiringShardedConcurrentUnorderedMapTests, incremental_sweep) {
+    ExpiringShardedUnorderedMap<int32_t, int32_t, 4> m(std::chrono::seconds(10));
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_TRUE(m.insert(i, i, std::chrono::milliseconds(1)));
+    }
+    for (int32_t i = 100; i < 150; ++i) {
+      ASSERT_TRUE(m.insert(i, i));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_EQ(50, m.size());
+    ASSERT_EQ(150, m.stored_size());
+
+    // Each call visits a bounded number of buckets per shard; repeated
+    // calls cycle through and eventually reclaim every expired entry.
+    ExpiringShardedUnorderedMap<int32_t, int32_t, 4>::size_type reclaimed = 0;
+    for (int32_t calls = 0; calls < 1000 && reclaimed < 100; ++calls) {
+      reclaimed += m.sweep(8);
+    }
+    ASSERT_EQ(100, reclaimed);
+    ASSERT_EQ(50, m.size());
+    ASSERT_EQ(50, m.stored_size());
+    for (int32_t i = 100; i < 150; ++i) {
+      ASSERT_EQ(i, m.at(i));
+    }
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, pool_allocator) {
+    // Distinct default-constructed allocators own distinct arenas; copies
+    // (including rebound copies) share one.
+    ::concurrency::pool_allocator<int32_t> const a;
+    ::concurrency::pool_allocator<int32_t> const b;
+    ASSERT_NE(a, b);
+    ::concurrency::pool_allocator<int64_t> const a_rebound(a);
+    ASSERT_EQ(a, a_rebound);
+
+    using map_type =
+        UnorderedMap<int32_t, int32_t, std::hash<int32_t>, std::equal_to<int32_t>, ::concurrency::pool_allocator<std::pair<const int32_t, int32_t>>>;
+    map_type m;
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(m.insert({i, i * 2}));
+    }
+    // Erase then refill so reinsertion is served from the arena's free
+    // lists rather than fresh chunks.
+    for (int32_t i = 0; i < 1000; i += 2) {
+      ASSERT_EQ(1, m.erase(i));
+    }
+    for (int32_t i = 0; i < 1000; i += 2) {
+      ASSERT_TRUE(m.insert({i, i * 2}));
+    }
+    ASSERT_EQ(1000, m.size());
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_EQ(i * 2, m.at(i));
+    }
+    m.clear();
+    ASSERT_TRUE(m.empty());
+    ASSERT_TRUE(m.insert({42, 84}));
+    ASSERT_EQ(84, m.at(42));
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, pool_allocator) {
+    // Each shard default-constructs its allocator, so each gets its own
+    // arena; the full map surface works atop them.
+    using map_type = ShardedUnorderedMap<int32_t, std::string, ::concurrency::DefaultUnorderedMapShardCount, std::hash<int32_t>, std::equal_to<int32_t>,
+                                         ::concurrency::pool_allocator<std::pair<const int32_t, std::string>>>;
+    map_type m;
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(m.insert({i, std::to_string(i)}));
+    }
+    ASSERT_EQ(1000, m.size());
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_EQ(std::to_string(i), m.at(i));
+    }
+    m.clear();
+    ASSERT_TRUE(m.empty());
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_TRUE(m.insert({i, std::to_string(i)}));
+    }
+    ASSERT_EQ(100, m.size());
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, pool_allocator_copies_use_fresh_arenas) {
+    // The arena is unsynchronized and single-owner, so container copies
+    // must never share it: select_on_container_copy_construction hands
+    // out a fresh arena, and copy assignment does not propagate one.
+    ::concurrency::pool_allocator<int32_t> const a;
+    auto const copy_alloc = a.select_on_container_copy_construction();
+    ASSERT_NE(a, copy_alloc);
+
+    using map_type =
+        UnorderedMap<int32_t, int32_t, std::hash<int32_t>, std::equal_to<int32_t>, ::concurrency::pool_allocator<std::pair<const int32_t, int32_t>>>;
+    map_type m;
+    for (int32_t i = 0; i < 500; ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+
+    // A data() snapshot is a copy of the underlying container; it must
+    // allocate from (and later free into) its own arena, not the map's.
+    auto const snapshot = m.data();
+    ASSERT_NE(m.get_allocator().arena(), snapshot.get_allocator().arena());
+    ASSERT_EQ(500, snapshot.size());
+
+    // Copy construction and copy assignment likewise leave the source's
+    // arena alone; the copies are fully independent afterward.
+    map_type const copied(m);
+    ASSERT_NE(m.get_allocator().arena(), copied.get_allocator().arena());
+    ASSERT_EQ(m.data(), copied.data());
+    map_type assigned;
+    assigned = m;
+    ASSERT_NE(m.get_allocator().arena(), assigned.get_allocator().arena());
+    ASSERT_EQ(m.data(), assigned.data());
+    ASSERT_EQ(1, assigned.erase(0));
+    ASSERT_TRUE(m.find(0));
+
+    // Concurrent snapshots while a writer mutates the map: each copy
+    // works out of a private arena, so nothing races on the map's.
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+      threads.emplace_back([&m]() {
+        for (int32_t i = 0; i < 25; ++i) {
+          auto const snap = m.data();
+          ASSERT_GE(snap.size(), 500);
+        }
+      });
+    }
+    for (int32_t i = 500; i < 1000; ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+    for (auto &t: threads) {
+      t.join();
+    }
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, flat_hash_map_backend) {
+    using map_type = UnorderedMap<std::string, int32_t, std::hash<std::string>, std::equal_to<std::string>, std::allocator<std::pair<const std::string, int32_t>>,
+                                  ::concurrency::NullUnorderedMapStatsPolicy, ::concurrency::FlatBackend>;
+
+    map_type m;
+    ASSERT_TRUE(m.empty());
+    ASSERT_TRUE(m.insert({"foo", 1}));
+    ASSERT_FALSE(m.insert({"foo", 2}));
+    ASSERT_FALSE(m.insert_or_assign("foo", 3));
+    ASSERT_EQ(3, m.at("foo"));
+    ASSERT_TRUE(m.try_emplace("bar", 4));
+    ASSERT_TRUE(m.emplace("baz", 5));
+    ASSERT_EQ(3, m.size());
+    ASSERT_EQ(1, m.erase("bar"));
+    ASSERT_EQ(0, m.erase("bar"));
+    ASSERT_FALSE(m.find("bar"));
+    ASSERT_TRUE(m.find("baz"));
+    ASSERT_EQ(1, m.count("baz"));
+
+    // The predicate and iteration surfaces work atop flat storage too.
+    ASSERT_EQ(1, m.erase_if([](map_type::value_type const &el) { return el.second == 5; }));
+    map_type::size_type visited = 0;
+    m.for_each([&visited](map_type::value_type const &) { ++visited; });
+    ASSERT_EQ(1, visited);
+
+    // Node-style extract and re-insert (keys are copied, not spliced).
+    auto nh = m.extract("foo");
+    ASSERT_FALSE(nh.empty());
+    ASSERT_EQ("foo", nh.key());
+    ASSERT_TRUE(m.empty());
+    ASSERT_TRUE(m.insert(std::move(nh)));
+    ASSERT_EQ(3, m.at("foo"));
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, flat_hash_map_churn) {
+    // Insert/erase cycles exercise tombstone reuse and rehashing.
+    ::concurrency::FlatHashMap<int32_t, int32_t> m;
+    for (int32_t round = 0; round < 3; ++round) {
+      for (int32_t i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(m.insert({i, i + round}).second);
+      }
+      ASSERT_EQ(5000, m.size());
+      for (int32_t i = 0; i < 5000; i += 2) {
+        ASSERT_EQ(1, m.erase(i));
+      }
+      ASSERT_EQ(2500, m.size());
+      for (int32_t i = 0; i < 5000; ++i) {
+        ASSERT_EQ(i % 2 == 1, m.find(i) != m.end());
+      }
+      size_t iterated = 0;
+      for (auto const &el: m) {
+        ASSERT_EQ(el.first + round, el.second);
+        ++iterated;
+      }
+      ASSERT_EQ(2500, iterated);
+      m.clear();
+      ASSERT_TRUE(m.empty());
+    }
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, flat_hash_map_backend) {
+    using map_type = ShardedUnorderedMap<int32_t, std::string, 8, std::hash<int32_t>, std::equal_to<int32_t>, std::allocator<std::pair<const int32_t, std::string>>,
+                                         ::concurrency::NullUnorderedMapStatsPolicy, ::concurrency::FlatBackend>;
+
+    map_type m;
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(m.insert({i, std::to_string(i)}));
+    }
+    ASSERT_EQ(1000, m.size());
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_EQ(std::to_string(i), m.at(i));
+    }
+    auto const all = m.data();
+    ASSERT_EQ(1000, all.size());
+    ASSERT_EQ(1, m.erase(7));
+    ASSERT_FALSE(m.find(7));
+    ASSERT_EQ(999, m.size());
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, fast_hash) {
+    // The transparent string specializations hash all string-ish
+    // spellings of the same bytes identically.
+    ::concurrency::fast_hash<std::string> h;
+    std::string const str = "the quick brown fox";
+    ASSERT_EQ(h(str), h(std::string_view(str)));
+    ASSERT_EQ(h(str), h(str.c_str()));
+    ASSERT_NE(h(str), h(std::string_view("the quick brown fax")));
+    ASSERT_EQ(h(""), h(std::string_view("")));
+
+    // Integers are actually mixed, unlike the common std::hash identity.
+    ::concurrency::fast_hash<uint64_t> ih;
+    ASSERT_NE(1U, ih(1));
+    ASSERT_NE(ih(1), ih(2));
+    ASSERT_EQ(ih(42), ih(42));
+
+    // 0.0 and -0.0 compare equal, so they must hash equal.
+    ::concurrency::fast_hash<double> dh;
+    ASSERT_EQ(dh(0.0), dh(-0.0));
+    ASSERT_NE(dh(1.0), dh(2.0));
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, transparent_lookup) {
+    using map_type = UnorderedMap<std::string, int32_t, ::concurrency::fast_hash<std::string>, std::equal_to<>>;
+
+    map_type m{
+        {"foo", 1},
+        {"bar", 2},
+        {"baz", 3},
+    };
+    std::string_view const probe("foo");
+    ASSERT_TRUE(m.find(probe));
+    ASSERT_EQ(1, m.count(probe));
+    ASSERT_EQ(1, m.at(probe));
+    ASSERT_FALSE(m.find(std::string_view("qux")));
+    try {
+      (void) m.at(std::string_view("qux"));
+      FAIL() << "Expected std::out_of_range.";
+    } catch (std::out_of_range const &) {
+    } catch (...) {
+      FAIL() << "Expected std::out_of_range.";
+    }
+    ASSERT_EQ(1, m.erase(std::string_view("bar")));
+    ASSERT_EQ(0, m.erase(std::string_view("bar")));
+    ASSERT_EQ(2, m.size());
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, transparent_lookup) {
+    using map_type = ShardedUnorderedMap<std::string, int32_t, 8, ::concurrency::fast_hash<std::string>, std::equal_to<>>;
+
+    map_type m;
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_TRUE(m.insert({std::to_string(i), i}));
+    }
+    for (int32_t i = 0; i < 100; ++i) {
+      std::string const key = std::to_string(i);
+      std::string_view const probe(key);
+      ASSERT_TRUE(m.find(probe));
+      ASSERT_EQ(1, m.count(probe));
+      ASSERT_EQ(i, m.at(probe));
+    }
+    ASSERT_FALSE(m.find(std::string_view("100")));
+    ASSERT_EQ(1, m.erase(std::string_view("42")));
+    ASSERT_EQ(99, m.size());
+  }
+
+  TEST_F(UnshardedConcurrentUnorderedMapTests, stats) {
+    using map_type = UnorderedMap<int32_t, int32_t, std::hash<int32_t>, std::equal_to<int32_t>, std::allocator<std::pair<const int32_t, int32_t>>, ::concurrency::UnorderedMapStatsPolicy>;
+
+    map_type m;
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+    for (int32_t i = 0; i < 100; ++i) {
+      ASSERT_TRUE(m.find(i));
+    }
+    auto const stats = m.stats();
+    ASSERT_GE(stats.write_lock_acquisitions, 100);
+    ASSERT_GE(stats.read_lock_acquisitions, 100);
+    ASSERT_EQ(100, stats.element_count);
+    ASSERT_GE(stats.read_lock_wait.count(), 0);
+    ASSERT_GE(stats.write_lock_wait.count(), 0);
+
+    // The default policy records nothing.
+    UnorderedMap<int32_t, int32_t> untracked;
+    ASSERT_TRUE(untracked.insert({1, 1}));
+    ASSERT_TRUE(untracked.find(1));
+    auto const none = untracked.stats();
+    ASSERT_EQ(0, none.read_lock_acquisitions);
+    ASSERT_EQ(0, none.write_lock_acquisitions);
+    ASSERT_EQ(1, none.element_count);
+  }
+
+  TEST_F(ShardedConcurrentUnorderedMapTests, shard_stats) {
+    constexpr uint32_t shards = 8;
+    using map_type = ShardedUnorderedMap<int32_t, int32_t, shards, std::hash<int32_t>, std::equal_to<int32_t>, std::allocator<std::pair<const int32_t, int32_t>>,
+                                         ::concurrency::UnorderedMapStatsPolicy>;
+
+    map_type m;
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(m.insert({i, i}));
+    }
+    for (int32_t i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(m.find(i));
+    }
+
+    uint64_t read_ops = 0, write_ops = 0;
+    size_t elements = 0;
+    for (uint32_t i = 0; i < shards; ++i) {
+      auto const st = m.shard_stats(i);
+      read_ops += st.read_lock_acquisitions;
+      write_ops += st.write_lock_acquisitions;
+      elements += st.element_count;
+    }
+    ASSERT_GE(write_ops, 1000);
+    ASSERT_GE(read_ops, 1000);
+    ASSERT_EQ(1000, elements);
+
+    auto const summary = m.stats_summary();
+    ASSERT_EQ(read_ops, summary.total_read_ops);
+    ASSERT_EQ(write_ops, summary.total_write_ops);
+    ASSERT_LE(summary.min_shard_ops, summary.max_shard_ops);
+    ASSERT_NEAR(static_cast<double>(read_ops + write_ops) / shards, summary.mean_shard_ops, 0.0001);
+    ASSERT_NEAR(1000.0 / shards, summary.mean_shard_elements, 0.0001);
+    ASSERT_GE(summary.stddev_shard_ops, 0.0);
+    ASSERT_LE(summary.min_shard_elements, summary.max_shard_elements);
+  }
+
+  TEST_F(DynamicShardedConcurrentUnorderedMapTests, shard_count) {
+    using map_type = DynamicShardedUnorderedMap<int32_t, int32_t>;
+
+    ASSERT_EQ(::concurrency::DefaultUnorderedMapShardCount, map_type().shard_count());
+    for (uint32_t const shards: {1U, 8U, 64U}) {
+      map_type m(shards);
+      ASSERT_EQ(shards, m.shard_count());
+      for (int32_t i = 0; i < 100; ++i) {
+        ASSERT_TRUE(m.insert({i, i * 3}));
+      }
+      ASSERT_EQ(100, m.size());
+      for (int32_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(i * 3, m.at(i));
+      }
+      uint32_t shards_seen = 0;
+      m.for_each_shard([&shards_seen](uint32_t const idx, map_type::shard_type const &) {
+        ASSERT_EQ(shards_seen, idx);
+        ++shards_seen;
+      });
+      ASSERT_EQ(shards, shards_seen);
+    }
+  }
+
+  TEST_F(DynamicShardedConcurrentUnorderedMapTests, zero_shards_throws) {
+    try {
+      DynamicShardedUnorderedMap<int32_t, int32_t> m(0);
+      FAIL() << "Expected std::invalid_argument.";
+    } catch (std::invalid_argument const &) {
+    } catch (...) {
+      FAIL() << "Expected std::invalid_argument.";
+    }
+  }
+
+  TEST_F(DynamicShardedConcurrentUnorderedMapTests, swap_different_shard_counts) {
+    using map_type = DynamicShardedUnorderedMap<int32_t, int32_t>;
+
+    map_type m1(4);
+    map_type m2(16);
+    ASSERT_TRUE(m1.insert({1, 10}));
+    ASSERT_TRUE(m2.insert({2, 20}));
+    m1.swap(m2);
+    // Each map keeps the other's shard count along with its contents.
+    ASSERT_EQ(16, m1.shard_count());
+    ASSERT_EQ(4, m2.shard_count());
+    ASSERT_EQ(20, m1.at(2));
+    ASSERT_EQ(10, m2.at(1));
+    ASSERT_FALSE(m1.find(1));
+    ASSERT_FALSE(m2.find(2));
+  }
+
+  TEST_F(DynamicShardedConcurrentUnorderedMapTests, batch_operations) {
+    using map_type = DynamicShardedUnorderedMap<int32_t, std::string>;
+
+    map_type m(8);
+    std::vector<map_type::value_type> values;
+    for (int32_t i = 0; i < 500; ++i) {
+      values.push_back({i, std::to_string(i)});
+    }
+    ASSERT_EQ(values.size(), m.insert_batch(values));
+    ASSERT_EQ(values.size(), m.size());
+
+    std::vector<int32_t> keys = {3, 499, 500, -1, 0};
+    auto const results        = m.find_many(keys);
+    ASSERT_EQ(keys.size(), results.size());
+    ASSERT_TRUE(results[0] && "3" == *results[0]);
+    ASSERT_TRUE(results[1] && "499" == *results[1]);
+    ASSERT_FALSE(results[2]);
+    ASSERT_FALSE(results[3]);
+    ASSERT_TRUE(results[4] && "0" == *results[4]);
+  }
+
+  TEST_F(AsyncShardedConcurrentUnorderedMapTests, basics) {
+    AsyncShardedUnorderedMap<std::string, int32_t> m;
+    ASSERT_GE(m.worker_count(), 1);
+    ASSERT_TRUE(m.async_insert({"foo", 1}).get());
+    ASSERT_FALSE(m.async_insert({"foo", 2}).get());
+    ASSERT_EQ(1, m.async_at("foo").get());
+    ASSERT_FALSE(m.async_insert_or_assign("foo", 3).get());
+    ASSERT_TRUE(m.async_insert_or_assign("bar", 4).get());
+    ASSERT_EQ(3, m.async_at("foo").get());
+    ASSERT_TRUE(m.async_visit("bar", [](int32_t &val) { val *= 10; }).get());
+    ASSERT_EQ(40, m.async_at("bar").get());
+    ASSERT_EQ(41, m.async_fetch_add("bar", 1).get());
+    ASSERT_TRUE(m.async_find("bar").get());
+    ASSERT_EQ(1, m.async_erase("bar").get());
+    ASSERT_FALSE(m.async_find("bar").get());
+    // The underlying map remains available for synchronous access.
+    ASSERT_EQ(1, m.map().size());
+  }
+
+  TEST_F(AsyncShardedConcurrentUnorderedMapTests, exceptions_propagate_through_futures) {
+    AsyncShardedUnorderedMap<std::string, int32_t> m;
+    auto fut = m.async_at("absent");
+    ASSERT_THROW(fut.get(), std::out_of_range);
+  }
+
+  TEST_F(AsyncShardedConcurrentUnorderedMapTests, same_shard_operations_are_ordered) {
+    AsyncShardedUnorderedMap<int32_t, int64_t> m(2);
+    // Enqueue without waiting; a later read on the same key must observe
+    // every earlier write because same-shard operations drain FIFO.
+    constexpr int64_t adds = 1000;
+    for (int64_t i = 0; i < adds; ++i) {
+      (void) m.async_fetch_add(7, 1);
+    }
+    ASSERT_EQ(adds, m.async_at(7).get());
+  }
+
+  TEST_F(AsyncShardedConcurrentUnorderedMapTests, concurrent_submitters) {
+    AsyncShardedUnorderedMap<int32_t, int64_t> m;
+    constexpr int32_t num_threads     = 8;
+    constexpr int64_t adds_per_thread = 500;
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&m]() {
+        std::vector<std::future<int64_t>> futures;
+        for (int64_t i = 0; i < adds_per_thread; ++i) {
+          futures.push_back(m.async_fetch_add(static_cast<int32_t>(i % 16), 1));
+        }
+        for (auto &f: futures) {
+          (void) f.get();
+        }
+      });
+    }
+    for (auto &t: threads) {
+      t.join();
+    }
+    int64_t total = 0;
+    for (int32_t k = 0; k < 16; ++k) {
+      total += m.map().at(k);
+    }
+    ASSERT_EQ(num_threads * adds_per_thread, total);
+  }
 } // anonymous namespace
\ No newline at end of file